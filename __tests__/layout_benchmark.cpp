@@ -0,0 +1,84 @@
+#include <ast/arena.hpp>
+#include <ast/layout.hpp>
+#include <ast/node.hpp>
+#include <ast/pool.hpp>
+#include <ast/style.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "menu_view.hpp"
+
+using namespace std;
+
+const unsigned int SCREEN_WIDTH = 100;
+const size_t FRAMES = 5000;
+const size_t DESCRIPTIONS = 8;
+const size_t MENU_ITEMS = 10;
+const size_t CART_ITEMS = 20;
+
+/**
+ *
+ * Average time to lay out a freshly built frame, in microseconds.
+ * Building the trees isn't timed.
+ */
+static double benchmarkLayout(NodeArena& arena, const MenuViewTexts& texts) {
+    chrono::nanoseconds total(0);
+
+    for (size_t frame = 0; frame < FRAMES; ++frame) {
+        ContainerNode* root = buildMenuView(arena, texts, SCREEN_WIDTH, frame);
+        auto start = chrono::steady_clock::now();
+
+        root->layout(SCREEN_WIDTH);
+
+        total += chrono::steady_clock::now() - start;
+        arena.reset();
+    }
+
+    return chrono::duration<double, micro>(total).count() / FRAMES;
+}
+
+int main() {
+    initializeLayoutStore();
+    initializeNodePools();
+    initializeTextStyleTable();
+
+    LayoutStore& store = getLayoutStore();
+    NodeArena arena;
+    MenuViewTexts texts;
+
+    texts.title = "School POS System";
+    texts.price = "Base price: 120.00";
+    texts.cartItemPrice = "x1  120.00";
+    texts.separator = string(SCREEN_WIDTH, '-');
+
+    for (size_t i = 0; i < MENU_ITEMS; ++i) {
+        texts.menuItems.push_back("menu-item-" + to_string(i));
+    }
+
+    for (size_t i = 0; i < DESCRIPTIONS; ++i) {
+        texts.descriptions.push_back(string(60 + 15 * i, 'd'));
+    }
+
+    for (size_t i = 0; i < CART_ITEMS; ++i) {
+        texts.cartItems.push_back("item-" + to_string(i));
+    }
+
+    store.setIsMeasureCacheEnabled(false);
+
+    double uncached = benchmarkLayout(arena, texts);
+
+    store.setIsMeasureCacheEnabled(true);
+    store.resetMeasureCacheStats();
+
+    double cached = benchmarkLayout(arena, texts);
+    MeasureCacheStats stats = store.getMeasureCacheStats();
+
+    cout << "layout of " << FRAMES << " repeated frames" << endl;
+    cout << "  without measure cache: " << uncached << " us/frame" << endl;
+    cout << "  with measure cache:    " << cached << " us/frame" << endl;
+    cout << "  cache hits: " << stats.hits << ", misses: " << stats.misses
+         << ", hit rate: " << stats.hitRate() * 100 << "%" << endl;
+
+    return 0;
+}
@@ -0,0 +1,564 @@
+#include <ast/arena.hpp>
+#include <ast/layout.hpp>
+#include <ast/node.hpp>
+#include <ast/pool.hpp>
+#include <ast/style.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utils.hpp>
+#include <vector>
+
+#include "random_tree.hpp"
+
+using namespace std;
+
+const uint32_t DEFAULT_SEED = 48;
+const size_t DEFAULT_TREES = 100;
+const size_t MUTATIONS = 40;
+/** Cells hit tested after every layout */
+const size_t HIT_TESTS = 8;
+/** Texts wrapped on their own after every layout */
+const size_t WRAPS = 4;
+/**
+ *
+ * Threads measuring the trees but the one made from scratch
+ * without the cache, which the others are checked against, and
+ * the nodes a run of siblings needs to get a thread of its own
+ */
+const size_t PARALLEL_THREADS = 4;
+const uint32_t PARALLEL_MIN_NODES = 8;
+
+struct Geometry {
+    unsigned int posX;
+    unsigned int posY;
+    unsigned int width;
+    unsigned int height;
+
+    bool operator==(const Geometry& other) const noexcept {
+        return posX == other.posX && posY == other.posY &&
+               width == other.width && height == other.height;
+    }
+};
+
+static ostream& operator<<(ostream& out, const Geometry& geometry) {
+    return out << "(" << geometry.posX << ", " << geometry.posY << ") "
+               << geometry.width << "x" << geometry.height;
+}
+
+/**
+ *
+ * Geometry of every node under `node`, in preorder
+ */
+static void collectGeometry(const Node* node, vector<Geometry>& geometry) {
+    geometry.push_back({node->getPosX(), node->getPosY(), node->getWidth(),
+                        node->getHeight()});
+
+    for (const Node* c = node->getFirstChild(); c != nullptr;
+         c = c->getNextSibling()) {
+        collectGeometry(c, geometry);
+    }
+}
+
+static bool overlaps(NodeHandle a, NodeHandle b) noexcept {
+    const LayoutStore& store = getLayoutStore();
+
+    return store.offsetX[a] < store.offsetX[b] + store.width[b] &&
+           store.offsetX[b] < store.offsetX[a] + store.width[a] &&
+           store.offsetY[a] < store.offsetY[b] + store.height[b] &&
+           store.offsetY[b] < store.offsetY[a] + store.height[a];
+}
+
+/**
+ *
+ * Whether a child can stick out of the right side of the node.
+ * Flex rows overflow when their items can't shrink enough, and
+ * grids with fixed cells wider than themselves overflow too.
+ */
+static bool canOverflow(NodeHandle node) noexcept {
+    const LayoutStore& store = getLayoutStore();
+
+    return store.kind[node] == FLEX_LAYOUT ||
+           (store.kind[node] == GRID_LAYOUT &&
+            store.childWidth[node] > store.width[node]);
+}
+
+/**
+ *
+ * Checks what has to hold for every laid out tree. Returns an
+ * empty string if it does, or what didn't.
+ */
+static string checkInvariants(const Node* node) {
+    const LayoutStore& store = getLayoutStore();
+    NodeHandle n = node->getHandle();
+    ostringstream failure;
+
+    if (store.flags[n] & (LAYOUT_DIRTY | CHILD_LAYOUT_DIRTY)) {
+        failure << "node " << n << " is still dirty";
+    } else if (store.width[n] > store.measuredInWidth[n]) {
+        failure << "node " << n << " is " << store.width[n]
+                << " wide in a width of " << store.measuredInWidth[n];
+    }
+
+    for (const Node* c = node->getFirstChild();
+         c != nullptr && failure.tellp() == 0; c = c->getNextSibling()) {
+        NodeHandle h = c->getHandle();
+
+        if (store.posX[h] != store.posX[n] + store.offsetX[h] ||
+            store.posY[h] != store.posY[n] + store.offsetY[h]) {
+            failure << "node " << h << " isn't where its parent put it";
+        } else if (store.offsetY[h] + store.height[h] > store.height[n]) {
+            failure << "node " << h << " sticks out of the bottom of " << n;
+        } else if (!canOverflow(n) &&
+                   store.offsetX[h] + store.width[h] > store.width[n]) {
+            failure << "node " << h << " sticks out of the right of " << n;
+        }
+
+        if (store.width[h] == 0 || store.height[h] == 0) {
+            continue;
+        }
+
+        for (const Node* s = c->getNextSibling();
+             s != nullptr && failure.tellp() == 0; s = s->getNextSibling()) {
+            NodeHandle sh = s->getHandle();
+
+            if (store.width[sh] > 0 && store.height[sh] > 0 &&
+                overlaps(h, sh)) {
+                failure << "siblings " << h << " and " << sh << " overlap";
+            }
+        }
+    }
+
+    for (const Node* c = node->getFirstChild();
+         c != nullptr && failure.tellp() == 0; c = c->getNextSibling()) {
+        failure << checkInvariants(c);
+    }
+
+    return failure.str();
+}
+
+struct DepthNode {
+    const Node* node;
+    unsigned int depth;
+};
+
+static void collectDepths(const Node* node, unsigned int depth,
+                          vector<DepthNode>& nodes) {
+    nodes.push_back({node, depth});
+
+    for (const Node* c = node->getFirstChild(); c != nullptr;
+         c = c->getNextSibling()) {
+        collectDepths(c, depth + 1, nodes);
+    }
+}
+
+/** Nodes without an area cover no cell */
+static bool covers(const Node* node, unsigned int col, unsigned int row,
+                   unsigned int w, unsigned int h) noexcept {
+    return node->getWidth() > 0 && node->getHeight() > 0 &&
+           node->getPosX() < col + w &&
+           col < node->getPosX() + node->getWidth() &&
+           node->getPosY() < row + h &&
+           row < node->getPosY() + node->getHeight();
+}
+
+/**
+ *
+ * Checks what the spatial index of the tree finds against a
+ * walk of the tree, at a few random cells and in one random
+ * region. Returns an empty string if they agree.
+ */
+static string checkSpatialIndex(const Node* root, RandomTree& tree) {
+    vector<DepthNode> nodes;
+    ostringstream failure;
+
+    collectDepths(root, 0, nodes);
+
+    unsigned int bottom = root->getHeight() + 2;
+
+    for (size_t i = 0; i < HIT_TESTS && failure.tellp() == 0; ++i) {
+        unsigned int col = tree.between(0, 160);
+        unsigned int row = tree.between(0, bottom);
+        const Node* hit = root->hitTest(col, row);
+        const DepthNode* deepest = nullptr;
+
+        for (const DepthNode& n : nodes) {
+            if (covers(n.node, col, row, 1, 1) &&
+                (deepest == nullptr || n.depth > deepest->depth)) {
+                deepest = &n;
+            }
+        }
+
+        if (deepest == nullptr ? hit != nullptr
+                               : hit == nullptr ||
+                                     !covers(hit, col, row, 1, 1)) {
+            failure << "hit test at (" << col << ", " << row
+                    << ") found another node than a walk of the tree";
+        } else if (deepest != nullptr) {
+            for (const DepthNode& n : nodes) {
+                if (n.node == hit && n.depth != deepest->depth) {
+                    failure << "hit test at (" << col << ", " << row
+                            << ") found a node at depth " << n.depth
+                            << " over one at depth " << deepest->depth;
+                }
+            }
+        }
+    }
+
+    unsigned int col = tree.between(0, 160);
+    unsigned int row = tree.between(0, bottom);
+    unsigned int w = tree.between(1, 40);
+    unsigned int h = tree.between(1, 40);
+    vector<Node*> found;
+    vector<const Node*> walked;
+
+    root->findNodesIn(col, row, w, h, found);
+
+    for (const DepthNode& n : nodes) {
+        if (covers(n.node, col, row, w, h)) {
+            walked.push_back(n.node);
+        }
+    }
+
+    sort(found.begin(), found.end());
+    sort(walked.begin(), walked.end());
+
+    if (failure.tellp() == 0 &&
+        !equal(found.begin(), found.end(), walked.begin(), walked.end())) {
+        failure << "the region at (" << col << ", " << row << ") of " << w
+                << "x" << h << " holds " << found.size()
+                << " nodes in the index, but " << walked.size()
+                << " in a walk of the tree";
+    }
+
+    return failure.str();
+}
+
+/**
+ *
+ * Checks the lines the text wraps to in the given width. No
+ * line may be empty or only spaces, unless the text is, and none
+ * may be wider than the width but a single character. Lines go
+ * forward and leave out only spaces. Returns an empty string if
+ * all of that holds.
+ */
+static string checkWrap(const string& text, unsigned int w) {
+    TextLines wrapped(&text);
+    const vector<TextLine>& lines = wrapped.wrap(w);
+    bool isBlank = text.find_first_not_of(' ') == string::npos;
+    uint32_t prevEnd = 0;
+    ostringstream failure;
+
+    failure << "\"" << text << "\" in a width of " << w << ": ";
+
+    for (size_t i = 0; i < lines.size(); ++i) {
+        string line = text.substr(lines[i].begin,
+                                  lines[i].end - lines[i].begin);
+        char32_t codePoint;
+
+        if (lines[i].begin < prevEnd || lines[i].end < lines[i].begin) {
+            failure << "line " << i << " goes backwards";
+        } else if (!isBlank && line.find_first_not_of(' ') == string::npos) {
+            failure << "line " << i << " is only \"" << line << "\"";
+        } else if (string_utils::displayWidth(line) > w &&
+                   string_utils::decodeUtf8(line, 0, codePoint) !=
+                       line.size()) {
+            failure << "line " << i << " \"" << line << "\" is too wide";
+        } else {
+            for (uint32_t j = prevEnd; j < lines[i].begin; ++j) {
+                if (text[j] != ' ') {
+                    failure << "line " << i << " leaves out \""
+                            << text.substr(prevEnd, lines[i].begin - prevEnd)
+                            << "\"";
+
+                    break;
+                }
+            }
+        }
+
+        if (failure.str().back() != ' ') {
+            return failure.str();
+        }
+
+        prevEnd = lines[i].end;
+    }
+
+    if (isBlank ? lines.size() != 1
+                : text.find_first_not_of(' ', prevEnd) != string::npos) {
+        failure << "the text doesn't end up in " << lines.size() << " lines";
+
+        return failure.str();
+    }
+
+    return "";
+}
+
+/**
+ *
+ * Indices of the nodes in the tree, leaving out the ones
+ * taken out of it
+ */
+static void collectAttached(const RandomTree& tree, size_t idx,
+                            vector<size_t>& attached) {
+    attached.push_back(idx);
+
+    for (size_t child : tree.nodes[idx].children) {
+        collectAttached(tree, child, attached);
+    }
+}
+
+/**
+ *
+ * Makes one random change to both the description of the tree
+ * and the nodes made from it
+ */
+static void mutate(RandomTree& tree, vector<Node*>& made, NodeArena& arena,
+                   unsigned int& availableWidth) {
+    vector<size_t> attached;
+
+    collectAttached(tree, 0, attached);
+
+    size_t idx = attached[tree.between(0, attached.size() - 1)];
+    RandomNode& props = tree.nodes[idx];
+    Node* node = made[idx];
+
+    switch (tree.between(0, 8)) {
+        case 0: {
+            if (!tree.isContainer(idx)) {
+                return;
+            }
+
+            size_t child = tree.addRandomNode();
+
+            // the node may have moved as the vector grew
+            tree.nodes[idx].children.push_back(child);
+            node->appendChild(tree.make(arena, child, made));
+        }; break;
+        case 1: {
+            if (props.children.empty()) {
+                return;
+            }
+
+            size_t i = tree.between(0, props.children.size() - 1);
+
+            props.children.erase(props.children.begin() + i);
+            node->removeChildAt(i);
+        }; break;
+        case 2: {
+            if (props.kind != RANDOM_TEXT) {
+                return;
+            }
+
+            props.text = tree.randomText();
+            static_cast<TextNode*>(node)->setText(props.text);
+        }; break;
+        case 3: {
+            if (props.kind == RANDOM_TEXT) {
+                props.width = tree.between(1, 60);
+            } else if (props.kind == RANDOM_GRID ||
+                       props.kind == RANDOM_FLEX) {
+                props.width = tree.between(max(1u, props.childWidth), 120);
+            } else {
+                return;
+            }
+
+            node->setWidth(props.width);
+        }; break;
+        case 4: {
+            // grids take no gap of 0 between columns
+            props.colGap = tree.between(props.kind == RANDOM_GRID ? 1 : 0, 4);
+            props.rowGap = tree.between(0, 2);
+
+            if (props.kind == RANDOM_GRID) {
+                static_cast<GridNode*>(node)->setColGap(props.colGap);
+                static_cast<GridNode*>(node)->setRowGap(props.rowGap);
+            } else if (props.kind == RANDOM_FLEX) {
+                static_cast<FlexNode*>(node)->setColGap(props.colGap);
+                static_cast<FlexNode*>(node)->setRowGap(props.rowGap);
+            }
+        }; break;
+        case 5: {
+            props.flexGrow = tree.between(0, 3);
+            props.flexShrink = tree.between(0, 3);
+            props.flexBasis = tree.chance(50) ? tree.between(0, 40) : 0;
+            node->setFlexGrow(props.flexGrow);
+            node->setFlexShrink(props.flexShrink);
+            node->setFlexBasis(props.flexBasis);
+        }; break;
+        case 6: {
+            props.isFlexible = !props.isFlexible;
+
+            if (props.kind == RANDOM_GRID) {
+                static_cast<GridNode*>(node)->setIsFlexible(props.isFlexible);
+            } else if (props.kind == RANDOM_FLEX) {
+                static_cast<FlexNode*>(node)->setIsWrapping(props.isFlexible);
+            }
+        }; break;
+        case 7: {
+            if (props.kind != RANDOM_TEXT && props.kind != RANDOM_LINE_BREAK) {
+                return;
+            }
+
+            props.height = tree.between(1, 3);
+            node->setHeight(props.height);
+        }; break;
+        case 8: {
+            availableWidth = tree.between(1, 150);
+        }; break;
+    }
+}
+
+/**
+ *
+ * Lays out a tree made fresh from the description on the given
+ * number of threads. Returns its geometry.
+ */
+static vector<Geometry> layoutFresh(const RandomTree& tree,
+                                    unsigned int availableWidth,
+                                    bool isMeasureCacheEnabled,
+                                    size_t threadCount) {
+    LayoutStore& store = getLayoutStore();
+    NodeArena arena;
+    vector<Node*> made;
+    vector<Geometry> geometry;
+
+    store.setIsMeasureCacheEnabled(isMeasureCacheEnabled);
+    store.setMeasureThreadCount(threadCount);
+
+    Node* root = tree.make(arena, 0, made);
+
+    root->layout(availableWidth);
+    collectGeometry(root, geometry);
+    store.setIsMeasureCacheEnabled(true);
+    store.setMeasureThreadCount(PARALLEL_THREADS);
+
+    return geometry;
+}
+
+/**
+ *
+ * Index of the first node the two differ at, or the size of
+ * the shorter one if they don't
+ */
+static size_t firstMismatch(const vector<Geometry>& a,
+                            const vector<Geometry>& b) {
+    size_t i = 0;
+
+    while (i < a.size() && i < b.size() && a[i] == b[i]) {
+        ++i;
+    }
+
+    return i;
+}
+
+int main(int argc, char **argv) {
+    initializeLayoutStore();
+    initializeNodePools();
+    initializeTextStyleTable();
+
+    getLayoutStore().setMeasureThreadCount(PARALLEL_THREADS);
+    getLayoutStore().setParallelMeasureMinNodes(PARALLEL_MIN_NODES);
+
+    uint32_t seed = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], 0, 10))
+                             : DEFAULT_SEED;
+    size_t trees = argc > 2 ? strtoul(argv[2], 0, 10) : DEFAULT_TREES;
+    size_t layouts = 0;
+
+    // an indent the first word doesn't fit beside used to make
+    // an empty line of its own
+    string indented = " hello world";
+    TextLines indentedLines(&indented);
+    const vector<TextLine>& lines = indentedLines.wrap(5);
+
+    if (lines.size() != 2 ||
+        indented.substr(lines[0].begin, lines[0].end - lines[0].begin) !=
+            "hello" ||
+        indented.substr(lines[1].begin, lines[1].end - lines[1].begin) !=
+            "world") {
+        cerr << "FAILED: \"" << indented << "\" doesn't wrap to \"hello\" "
+             << "and \"world\" in a width of 5" << endl;
+
+        return 1;
+    }
+
+    for (size_t t = 0; t < trees; ++t) {
+        RandomTree tree(seed + static_cast<uint32_t>(t));
+        NodeArena arena;
+        vector<Node*> made;
+
+        tree.grow(tree.between(1, 300));
+
+        Node* root = tree.make(arena, 0, made);
+        unsigned int availableWidth = tree.between(1, 150);
+
+        root->setIsSpatiallyIndexed(true);
+
+        for (size_t m = 0; m <= MUTATIONS; ++m) {
+            // a few changes at once, like a handler making several
+            if (m > 0) {
+                for (unsigned int i = tree.between(1, 3); i > 0; --i) {
+                    mutate(tree, made, arena, availableWidth);
+                }
+            }
+
+            root->layout(availableWidth);
+            ++layouts;
+
+            vector<Geometry> incremental;
+
+            collectGeometry(root, incremental);
+
+            string failure = checkInvariants(root);
+
+            if (failure.empty()) {
+                failure = checkSpatialIndex(root, tree);
+            }
+
+            for (size_t i = 0; i < WRAPS && failure.empty(); ++i) {
+                failure = checkWrap(tree.randomText(), tree.between(1, 40));
+            }
+
+            vector<Geometry> uncached =
+                layoutFresh(tree, availableWidth, false, 1);
+            vector<Geometry> cached =
+                layoutFresh(tree, availableWidth, true, PARALLEL_THREADS);
+            size_t i = firstMismatch(incremental, uncached);
+            size_t j = firstMismatch(cached, uncached);
+
+            if (failure.empty() && (incremental.size() != uncached.size() ||
+                                    cached.size() != uncached.size())) {
+                failure = "the tree made from scratch has another shape";
+            } else if (failure.empty() && i < uncached.size()) {
+                ostringstream out;
+
+                out << "node " << i << " in preorder was laid out at "
+                    << incremental[i] << ", but at " << uncached[i]
+                    << " in a tree made from scratch on one thread";
+                failure = out.str();
+            } else if (failure.empty() && j < uncached.size()) {
+                ostringstream out;
+
+                out << "node " << j << " in preorder was laid out at "
+                    << cached[j] << " with the measure cache, but at "
+                    << uncached[j] << " without it on one thread";
+                failure = out.str();
+            }
+
+            if (!failure.empty()) {
+                // `layout_fuzz_test <seed> 1` runs only the failing tree
+                cerr << "FAILED with seed " << seed + t << " after " << m
+                     << " rounds of changes, in a width of "
+                     << availableWidth << ": " << failure << endl;
+
+                return 1;
+            }
+        }
+    }
+
+    cout << "layout fuzz: " << trees << " trees from seed " << seed << ", "
+         << layouts << " layouts checked" << endl;
+
+    return 0;
+}
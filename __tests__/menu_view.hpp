@@ -0,0 +1,121 @@
+#pragma once
+
+#include <ast/arena.hpp>
+#include <ast/node.hpp>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+/**
+ *
+ * Every string a menu view is built from, made before the view
+ * is, like the menu data the app loads on start
+ */
+struct MenuViewTexts {
+    string title;
+    vector<string> menuItems;
+    /** Taken in turns, one per frame */
+    vector<string> descriptions;
+    string price;
+    /** The view has no cart under the menu without any */
+    vector<string> cartItems;
+    string cartItemPrice;
+    string separator;
+};
+
+inline void onMenuViewButtonPressed(unsigned int) {}
+
+/**
+ *
+ * A tree shaped like the menu view, in the given width. Only the
+ * description changes between frames, like when the selection
+ * moves.
+ */
+inline ContainerNode* buildMenuView(NodeArena& arena,
+                                    const MenuViewTexts& texts,
+                                    unsigned int screenWidth, size_t frame) {
+    ContainerNode* root = arena.make<ContainerNode>();
+    ContainerNode* header = arena.make<ContainerNode>();
+    ContainerNode* body = arena.make<ContainerNode>();
+    ContainerNode* footer = arena.make<ContainerNode>();
+
+    TextNode* title = arena.make<TextNode>(texts.title);
+    GridNode* nav = arena.make<GridNode>(screenWidth, 0, 2, 1);
+    ButtonNode* shopBtn =
+        arena.make<ButtonNode>("s", "shop", make_tuple(115, 83), true);
+    ButtonNode* adminBtn =
+        arena.make<ButtonNode>("a", "admin", make_tuple(97, 65));
+    ButtonNode* checkoutBtn =
+        arena.make<ButtonNode>("c", "checkout", make_tuple(99, 67));
+
+    title->setWidth(screenWidth);
+    title->setColor(255, 255, 0);
+    title->setBold();
+    shopBtn->subscribe(onMenuViewButtonPressed);
+    adminBtn->subscribe(onMenuViewButtonPressed);
+    checkoutBtn->subscribe(onMenuViewButtonPressed);
+    nav->appendChild(shopBtn);
+    nav->appendChild(adminBtn);
+    nav->appendChild(checkoutBtn);
+    header->appendChild(title);
+    header->appendChild(arena.make<LineBreakNode>(2));
+    header->appendChild(nav);
+
+    GridNode* menuGrid = arena.make<GridNode>(screenWidth);
+    SelectNode* menuSelect = arena.make<SelectNode>();
+    GridNode* itemDisplay = arena.make<GridNode>(screenWidth);
+
+    menuGrid->setIsFlexible(true);
+    itemDisplay->setRowGap(1);
+
+    for (const string& menuItem : texts.menuItems) {
+        menuSelect->appendChild(arena.make<SelectOptionNode>(menuItem));
+    }
+
+    itemDisplay->appendChild(arena.make<TextNode>(
+        texts.descriptions[frame % texts.descriptions.size()]));
+    itemDisplay->appendChild(arena.make<TextNode>(texts.price));
+    menuGrid->appendChild(menuSelect);
+    menuGrid->appendChild(itemDisplay);
+    body->appendChild(menuGrid);
+
+    if (!texts.cartItems.empty()) {
+        FlexNode* cart = arena.make<FlexNode>(screenWidth, 1, 1);
+
+        cart->setIsWrapping(true);
+
+        for (const string& cartItem : texts.cartItems) {
+            GridNode* item = arena.make<GridNode>(screenWidth / 7);
+
+            item->setFlexBasis(screenWidth / 7);
+            item->appendChild(arena.make<TextNode>(cartItem));
+            item->appendChild(arena.make<TextNode>(texts.cartItemPrice));
+            cart->appendChild(item);
+        }
+
+        body->appendChild(cart);
+    }
+
+    GridNode* toolTips = arena.make<GridNode>(screenWidth, 0, 2, 1);
+
+    toolTips->appendChild(
+        arena.make<ButtonNode>("⏎", "enter", make_tuple(0, 0), true));
+    toolTips->appendChild(
+        arena.make<ButtonNode>("↑/↓", "up/down", make_tuple(0, 0), true));
+    toolTips->appendChild(
+        arena.make<ButtonNode>("q", "quit", make_tuple(0, 0), true));
+    footer->appendChild(arena.make<TextNode>(texts.separator));
+    footer->appendChild(toolTips);
+    footer->appendChild(arena.make<TextNode>(texts.separator));
+
+    root->appendChild(header);
+    root->appendChild(arena.make<LineBreakNode>(2));
+    root->appendChild(body);
+    root->appendChild(arena.make<LineBreakNode>(3));
+    root->appendChild(footer);
+
+    return root;
+}
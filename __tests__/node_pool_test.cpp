@@ -0,0 +1,126 @@
+#include <ast/arena.hpp>
+#include <ast/layout.hpp>
+#include <ast/node.hpp>
+#include <ast/pool.hpp>
+#include <ast/style.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "menu_view.hpp"
+
+using namespace std;
+
+static size_t allocationCount = 0;
+
+void* operator new(size_t size) {
+    ++allocationCount;
+
+    if (void* memory = malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+
+    throw bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { free(memory); }
+
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+
+const unsigned int SCREEN_WIDTH = 100;
+const size_t WARM_UP_FRAMES = 4;
+const size_t FRAMES = 1000;
+const size_t MENU_ITEMS = 10;
+
+static size_t pooledNodeCount() {
+    NodePools& pools = getNodePools();
+
+    return pools.textNodes.size() + pools.gridNodes.size() +
+           pools.buttonNodes.size() + pools.selectOptionNodes.size() +
+           pools.lineBreakNodes.size();
+}
+
+static bool check(bool condition, const string& failure) {
+    if (!condition) {
+        cerr << "FAILED: " << failure << endl;
+    }
+
+    return condition;
+}
+
+int main() {
+    initializeLayoutStore();
+    initializeTextStyleTable();
+    initializeNodePools();
+
+    MenuViewTexts texts;
+
+    texts.title = "School POS System";
+
+    for (size_t i = 0; i < MENU_ITEMS; ++i) {
+        texts.menuItems.push_back("iced-spanish-latte-" + to_string(i));
+    }
+
+    texts.descriptions.push_back(
+        "Espresso with condensed milk and ice, for the long afternoons.");
+    texts.descriptions.push_back("Espresso with steamed milk.");
+    texts.price = "Base price: 120.00";
+    texts.separator = string(SCREEN_WIDTH, '-');
+
+    NodeArena arena;
+    bool passed = true;
+
+    for (size_t frame = 0; frame < WARM_UP_FRAMES; ++frame) {
+        buildMenuView(arena, texts, SCREEN_WIDTH, frame)->layout(SCREEN_WIDTH);
+        arena.reset();
+    }
+
+    size_t nodesAfterWarmUp = pooledNodeCount();
+    size_t allocationsBefore = allocationCount;
+
+    for (size_t frame = 0; frame < FRAMES; ++frame) {
+        buildMenuView(arena, texts, SCREEN_WIDTH, frame)->layout(SCREEN_WIDTH);
+        arena.reset();
+    }
+
+    size_t allocations = allocationCount - allocationsBefore;
+
+    passed &= check(allocations == 0,
+                    to_string(allocations) + " allocations in " +
+                        to_string(FRAMES) + " frames after warming up");
+    passed &= check(pooledNodeCount() == nodesAfterWarmUp,
+                    "nodes were made instead of reused");
+
+    // a reused node has to come back with the props it is made
+    // with, not the ones it had before
+    TextNode* styled = arena.make<TextNode>(texts.price);
+    SelectOptionNode* option = arena.make<SelectOptionNode>("hot-choco");
+
+    styled->setBold();
+    option->setColor(0, 0, 0);
+    arena.reset();
+
+    TextNode* text = arena.make<TextNode>(texts.title);
+    SelectOptionNode* reusedOption =
+        arena.make<SelectOptionNode>(texts.menuItems[3]);
+
+    passed &= check(text == styled && reusedOption == option,
+                    "nodes weren't reused");
+    passed &= check(
+        text->getText() == texts.title && text->getStyle().isPlain(),
+        "a reused text node kept its old text or style");
+    passed &= check(reusedOption->getValue() == "iced-spanish-latte-3" &&
+                        reusedOption->getText() == "Iced Spanish Latte 3" &&
+                        reusedOption->getKey() == "iced-spanish-latte-3" &&
+                        reusedOption->getStyle().isPlain(),
+                    "a reused select option kept its old props");
+
+    arena.reset();
+
+    cout << "node pools: " << pooledNodeCount() << " nodes, " << allocations
+         << " allocations in " << FRAMES << " frames" << endl;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <ast/arena.hpp>
+#include <ast/node.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+enum RandomNodeKind {
+    RANDOM_CONTAINER,
+    RANDOM_GRID,
+    RANDOM_FLEX,
+    RANDOM_TEXT,
+    RANDOM_BUTTON,
+    RANDOM_LINE_BREAK
+};
+
+/**
+ *
+ * Props of a node of a `RandomTree`, everything it takes to
+ * make the node again
+ */
+struct RandomNode {
+    RandomNodeKind kind;
+    /** 0 for none */
+    unsigned int width;
+    unsigned int height;
+    unsigned int childWidth;
+    unsigned int colGap;
+    unsigned int rowGap;
+    /** Whether a grid is flexible, or a flex container wraps */
+    bool isFlexible;
+    unsigned int flexGrow;
+    unsigned int flexShrink;
+    unsigned int flexBasis;
+    string text;
+    vector<size_t> children;
+};
+
+/**
+ *
+ * A random tree of nodes, described apart from the nodes, so the
+ * same tree can be made any number of times and changed along
+ * with nodes made from it. The first node is the root, a
+ * `ContainerNode`. Nodes taken out of the tree stay in `nodes`.
+ */
+class RandomTree {
+   public:
+    vector<RandomNode> nodes;
+    mt19937 rng;
+
+   public:
+    RandomTree(uint32_t seed) : rng(seed) {
+        nodes.push_back(makeProps(RANDOM_CONTAINER));
+    }
+
+   public:
+    /** Between `min` and `max`, both included */
+    unsigned int between(unsigned int min, unsigned int max) {
+        return uniform_int_distribution<unsigned int>(min, max)(rng);
+    }
+
+    bool chance(unsigned int percent) { return between(1, 100) <= percent; }
+
+    /**
+     *
+     * Words of different lengths, some of them wider than they
+     * are long, so texts wrap in different places
+     */
+    string randomText() {
+        static const char* const WORDS[] = {
+            "a",     "menu",  "latte", "espresso", "₱120.00", "café",
+            "抹茶",  "x",     "iced",  "caramel-macchiato",   "q",
+            "of",    "the",   "size",  "supercalifragilistic"};
+        const size_t wordCount = sizeof(WORDS) / sizeof(WORDS[0]);
+        unsigned int words = between(0, 12);
+        // some start with an indent, like the admin view's lists
+        string text(chance(10) ? between(1, 3) : 0, ' ');
+
+        for (unsigned int i = 0; i < words; ++i) {
+            if (i > 0) {
+                text += chance(10) ? "  " : " ";
+            }
+
+            text += WORDS[between(0, wordCount - 1)];
+        }
+
+        return text;
+    }
+
+    RandomNode makeProps(RandomNodeKind kind) {
+        RandomNode props{kind, 0, 0, 0, 0, 0, false, 0, 1, 0, "", {}};
+
+        switch (kind) {
+            case RANDOM_CONTAINER:
+                break;
+            case RANDOM_GRID:
+                props.width = between(1, 120);
+                props.childWidth = chance(25) ? between(0, props.width) : 0;
+                props.colGap = between(0, 4);
+                props.rowGap = between(0, 2);
+                props.isFlexible = chance(30);
+                break;
+            case RANDOM_FLEX:
+                props.width = between(1, 120);
+                props.colGap = between(0, 3);
+                props.rowGap = between(0, 2);
+                props.isFlexible = chance(50);
+                break;
+            case RANDOM_TEXT:
+                props.width = chance(50) ? between(1, 60) : 0;
+                props.height = between(1, 3);
+                props.text = randomText();
+                break;
+            case RANDOM_BUTTON:
+                props.text = randomText();
+                break;
+            case RANDOM_LINE_BREAK:
+                props.height = between(1, 3);
+                break;
+        }
+
+        if (chance(30)) {
+            props.flexGrow = between(0, 3);
+            props.flexShrink = between(0, 3);
+            props.flexBasis = chance(50) ? between(0, 40) : 0;
+        }
+
+        return props;
+    }
+
+    size_t addNode(RandomNodeKind kind) {
+        nodes.push_back(makeProps(kind));
+
+        return nodes.size() - 1;
+    }
+
+    /** Containers are picked less the more nodes there are */
+    size_t addRandomNode() {
+        unsigned int containerOdds = nodes.size() < 64 ? 45 : 25;
+
+        if (chance(containerOdds)) {
+            return addNode(static_cast<RandomNodeKind>(between(0, 2)));
+        }
+
+        return addNode(static_cast<RandomNodeKind>(between(3, 5)));
+    }
+
+    bool isContainer(size_t idx) const noexcept {
+        return nodes[idx].kind == RANDOM_CONTAINER ||
+               nodes[idx].kind == RANDOM_GRID ||
+               nodes[idx].kind == RANDOM_FLEX;
+    }
+
+    /**
+     *
+     * Adds nodes under random containers of the tree until it
+     * has `count` nodes, not counting the ones taken out
+     */
+    void grow(size_t count) {
+        vector<size_t> containers;
+
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (isContainer(i)) {
+                containers.push_back(i);
+            }
+        }
+
+        for (size_t n = countAttached(0); n < count; ++n) {
+            size_t parent = containers[between(0, containers.size() - 1)];
+            size_t child = addRandomNode();
+
+            nodes[parent].children.push_back(child);
+
+            if (isContainer(child)) {
+                containers.push_back(child);
+            }
+        }
+    }
+
+    size_t countAttached(size_t idx) const noexcept {
+        size_t count = 1;
+
+        for (size_t child : nodes[idx].children) {
+            count += countAttached(child);
+        }
+
+        return count;
+    }
+
+    /**
+     *
+     * Makes the node at `idx` and everything under it in the
+     * arena. `made` holds the node made for each index.
+     */
+    Node* make(NodeArena& arena, size_t idx, vector<Node*>& made) const {
+        const RandomNode& props = nodes[idx];
+        Node* node = nullptr;
+
+        switch (props.kind) {
+            case RANDOM_CONTAINER: {
+                node = arena.make<ContainerNode>();
+            }; break;
+            case RANDOM_GRID: {
+                GridNode* grid = arena.make<GridNode>(
+                    props.width, props.childWidth, props.colGap, props.rowGap);
+
+                grid->setIsFlexible(props.isFlexible);
+                node = grid;
+            }; break;
+            case RANDOM_FLEX: {
+                FlexNode* flex = arena.make<FlexNode>(
+                    props.width, props.colGap, props.rowGap);
+
+                flex->setIsWrapping(props.isFlexible);
+                node = flex;
+            }; break;
+            case RANDOM_TEXT: {
+                TextNode* text = arena.make<TextNode>(props.text);
+
+                if (props.width > 0) {
+                    text->setWidth(props.width);
+                }
+
+                text->setHeight(props.height);
+                node = text;
+            }; break;
+            case RANDOM_BUTTON: {
+                node =
+                    arena.make<ButtonNode>("x", props.text, make_tuple(0, 0));
+            }; break;
+            case RANDOM_LINE_BREAK: {
+                node = arena.make<LineBreakNode>(props.height);
+            }; break;
+        }
+
+        node->setFlexGrow(props.flexGrow);
+        node->setFlexShrink(props.flexShrink);
+        node->setFlexBasis(props.flexBasis);
+
+        if (made.size() < nodes.size()) {
+            made.resize(nodes.size(), nullptr);
+        }
+
+        made[idx] = node;
+
+        for (size_t child : props.children) {
+            node->appendChild(make(arena, child, made));
+        }
+
+        return node;
+    }
+};
@@ -0,0 +1,292 @@
+#include <ast/arena.hpp>
+#include <ast/layout.hpp>
+#include <ast/node.hpp>
+#include <ast/pool.hpp>
+#include <ast/style.hpp>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "random_tree.hpp"
+
+using namespace std;
+
+const uint32_t SEED = 48;
+const unsigned int SCREEN_WIDTH = 100;
+const size_t TREE_SIZES[] = {10, 100, 1000, 10000, 100000};
+/** Nodes laid out and painted per size, spread over enough runs */
+const size_t NODES_PER_SIZE = 200000;
+/** Cells looked up per run, in the index and by walking the tree */
+const size_t HIT_TESTS = 64;
+/** The report screen is a grid row of cells per line of the report */
+const unsigned int REPORT_ROWS = 1000;
+const unsigned int REPORT_COLS = 10;
+const size_t REPORT_RUNS = 20;
+const size_t REPORT_THREADS[] = {1, 2, 4, 8};
+
+struct TreeTimings {
+    double append;
+    double layout;
+    double relayout;
+    double render;
+    size_t renderedBytes;
+    double index;
+    double hitTest;
+    double walk;
+};
+
+static double elapsedMicros(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start)
+        .count();
+}
+
+/**
+ *
+ * Deepest node at the cell, found the way it is without an index
+ */
+static const Node* walkTo(const Node* node, unsigned int col,
+                          unsigned int row, unsigned int depth,
+                          unsigned int& hitDepth) {
+    const Node* hit = nullptr;
+
+    if (node->getWidth() > 0 && node->getHeight() > 0 &&
+        col >= node->getPosX() &&
+        col < node->getPosX() + node->getWidth() &&
+        row >= node->getPosY() &&
+        row < node->getPosY() + node->getHeight()) {
+        hit = node;
+        hitDepth = depth;
+    }
+
+    for (const Node* c = node->getFirstChild(); c != nullptr;
+         c = c->getNextSibling()) {
+        unsigned int childDepth = 0;
+        const Node* childHit = walkTo(c, col, row, depth + 1, childDepth);
+
+        if (childHit != nullptr && (hit == nullptr || childDepth > hitDepth)) {
+            hit = childHit;
+            hitDepth = childDepth;
+        }
+    }
+
+    return hit;
+}
+
+/**
+ *
+ * Header, a body of `REPORT_ROWS` grids of `REPORT_COLS` cells
+ * and a footer, like a report of every student's grades
+ */
+static Node* makeReport(NodeArena& arena) {
+    Node* root = arena.make<ContainerNode>();
+    Node* body = arena.make<ContainerNode>();
+
+    root->appendChild(arena.make<TextNode>("Grade report"));
+
+    for (unsigned int row = 0; row < REPORT_ROWS; ++row) {
+        GridNode* line =
+            arena.make<GridNode>(SCREEN_WIDTH, SCREEN_WIDTH / REPORT_COLS - 1,
+                                 1, 0);
+
+        for (unsigned int col = 0; col < REPORT_COLS; ++col) {
+            line->appendChild(arena.make<TextNode>(
+                "r" + to_string(row) + " c" + to_string(col) + " " +
+                string((row * 7 + col * 3) % 13, '#')));
+        }
+
+        body->appendChild(line);
+    }
+
+    root->appendChild(body);
+    root->appendChild(arena.make<TextNode>("End of report"));
+
+    return root;
+}
+
+static void collectGeometry(const Node* node, vector<unsigned int>& geometry) {
+    geometry.insert(geometry.end(), {node->getPosX(), node->getPosY(),
+                                     node->getWidth(), node->getHeight()});
+
+    for (const Node* c = node->getFirstChild(); c != nullptr;
+         c = c->getNextSibling()) {
+        collectGeometry(c, geometry);
+    }
+}
+
+/**
+ *
+ * Average time to lay out the report screen made fresh on the
+ * given number of threads, in microseconds. `geometry` is what
+ * it was laid out to.
+ */
+static double benchmarkReport(size_t threadCount,
+                              vector<unsigned int>& geometry) {
+    double elapsed = 0;
+
+    getLayoutStore().setMeasureThreadCount(threadCount);
+
+    for (size_t run = 0; run < REPORT_RUNS; ++run) {
+        NodeArena arena;
+        Node* root = makeReport(arena);
+
+        auto start = chrono::steady_clock::now();
+        root->layout(SCREEN_WIDTH);
+        elapsed += elapsedMicros(start);
+
+        if (run == 0) {
+            geometry.clear();
+            collectGeometry(root, geometry);
+        }
+    }
+
+    return elapsed / REPORT_RUNS;
+}
+
+/**
+ *
+ * Average time to make a random tree of `size` nodes and append
+ * them, to lay it out, to lay it out again after one text in it
+ * changed and to paint it, in microseconds. Then the time to
+ * index it, and to find the node at `HIT_TESTS` cells in the
+ * index and by walking the tree.
+ */
+static TreeTimings benchmarkTree(size_t size) {
+    RandomTree tree(SEED + static_cast<uint32_t>(size));
+    size_t runs = max<size_t>(1, NODES_PER_SIZE / size);
+    TreeTimings timings{0, 0, 0, 0, 0, 0, 0, 0};
+    vector<size_t> texts;
+
+    tree.grow(size);
+
+    for (size_t i = 0; i < tree.nodes.size(); ++i) {
+        if (tree.nodes[i].kind == RANDOM_TEXT) {
+            texts.push_back(i);
+        }
+    }
+
+    for (size_t run = 0; run < runs; ++run) {
+        NodeArena arena;
+        vector<Node*> made;
+        ostringstream buf;
+
+        auto start = chrono::steady_clock::now();
+        Node* root = tree.make(arena, 0, made);
+
+        timings.append += elapsedMicros(start);
+
+        start = chrono::steady_clock::now();
+        root->layout(SCREEN_WIDTH);
+        timings.layout += elapsedMicros(start);
+
+        if (!texts.empty()) {
+            TextNode* text =
+                static_cast<TextNode*>(made[texts[run % texts.size()]]);
+
+            text->setText(tree.randomText());
+        }
+
+        start = chrono::steady_clock::now();
+        root->layout(SCREEN_WIDTH);
+        timings.relayout += elapsedMicros(start);
+
+        start = chrono::steady_clock::now();
+        root->paint(&buf);
+        timings.render += elapsedMicros(start);
+        timings.renderedBytes = buf.str().size();
+
+        start = chrono::steady_clock::now();
+        root->setIsSpatiallyIndexed(true);
+        timings.index += elapsedMicros(start);
+
+        vector<pair<unsigned int, unsigned int>> cells;
+        const Node* hit = nullptr;
+
+        for (size_t i = 0; i < HIT_TESTS; ++i) {
+            cells.emplace_back(tree.between(0, SCREEN_WIDTH - 1),
+                               tree.between(0, root->getHeight()));
+        }
+
+        start = chrono::steady_clock::now();
+
+        for (auto& cell : cells) {
+            hit = root->hitTest(cell.first, cell.second);
+        }
+
+        timings.hitTest += elapsedMicros(start);
+        start = chrono::steady_clock::now();
+
+        for (auto& cell : cells) {
+            unsigned int depth = 0;
+
+            hit = walkTo(root, cell.first, cell.second, 0, depth);
+        }
+
+        timings.walk += elapsedMicros(start);
+        (void)hit;
+    }
+
+    timings.append /= runs;
+    timings.layout /= runs;
+    timings.relayout /= runs;
+    timings.render /= runs;
+    timings.index /= runs;
+    timings.hitTest /= runs;
+    timings.walk /= runs;
+
+    return timings;
+}
+
+int main() {
+    initializeLayoutStore();
+    initializeNodePools();
+    initializeTextStyleTable();
+
+    cout << "random trees in a width of " << SCREEN_WIDTH << ", us/tree"
+         << endl;
+
+    for (size_t size : TREE_SIZES) {
+        TreeTimings timings = benchmarkTree(size);
+
+        cout << "  " << size << " nodes" << endl;
+        cout << "    append:   " << timings.append << endl;
+        cout << "    layout:   " << timings.layout << endl;
+        cout << "    relayout: " << timings.relayout
+             << " (after changing one text)" << endl;
+        cout << "    render:   " << timings.render << " ("
+             << timings.renderedBytes << " bytes)" << endl;
+        cout << "    index:    " << timings.index << endl;
+        cout << "    " << HIT_TESTS << " hit tests: " << timings.hitTest
+             << " with the index, " << timings.walk << " walking the tree"
+             << endl;
+    }
+
+    size_t threadCount = getLayoutStore().getMeasureThreadCount();
+    vector<unsigned int> serialGeometry;
+    double serial = benchmarkReport(1, serialGeometry);
+
+    cout << "report screen of " << REPORT_ROWS * REPORT_COLS
+         << " cells, us/layout (" << thread::hardware_concurrency()
+         << " cores)" << endl;
+    cout << "  1 thread:  " << serial << endl;
+
+    for (size_t threads : REPORT_THREADS) {
+        if (threads == 1) {
+            continue;
+        }
+
+        vector<unsigned int> geometry;
+        double elapsed = benchmarkReport(threads, geometry);
+
+        cout << "  " << threads << " threads: " << elapsed << " ("
+             << serial / elapsed << "x)"
+             << (geometry == serialGeometry ? "" : " LAID OUT DIFFERENTLY")
+             << endl;
+    }
+
+    getLayoutStore().setMeasureThreadCount(threadCount);
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <chrono>
+#include <contrib/report.hpp>
+#include <contrib/utils.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+const char* const ORDERS_PATH = "z_report_benchmark_orders.csv";
+const char* const CHECKPOINT_PATH = "z_report_benchmark.checkpoint";
+/** A busy day at the end of a file of `DAYS` of them */
+const size_t DAYS = 60;
+const size_t ORDERS_PER_DAY = 3000;
+const size_t RUNS = 5;
+const char* const ITEM_NAMES[] = {"Cafe Latte", "Cappucino", "Americano",
+                                  "Hot Choco"};
+
+/**
+ *
+ * Writes `DAYS` days of single item orders, the last of them
+ * on the given day
+ */
+static void writeOrders(const tm& lastDay) {
+    ofstream file(ORDERS_PATH);
+    long lastEpochDay = daysSinceEpoch(lastDay);
+    size_t uid = 0;
+
+    file << "Order Uid,Item Uid,Date Created,Name,Base Price,Size,Quantity,"
+            "Subtotal,Total,Remarks,Order State\n";
+
+    for (size_t d = DAYS; d-- > 0;) {
+        string date = parseDate(
+            dateFromDaysSinceEpoch(lastEpochDay - static_cast<long>(d)));
+
+        for (size_t o = 0; o < ORDERS_PER_DAY; ++o, ++uid) {
+            const char* state = uid % 20 == 0 ? "CANCELLED" : "FINISHED";
+
+            file << "o" << uid << ",i" << uid << "," << date << ","
+                 << ITEM_NAMES[uid % 4] << ",110.00,TALL,2,220.00,220.00,,"
+                 << state << "\n";
+        }
+    }
+}
+
+int main() {
+    tm today = getCurrentDateTime();
+
+    writeOrders(today);
+
+    double elapsed = 0;
+    size_t orderCount = 0;
+
+    for (size_t run = 0; run < RUNS; ++run) {
+        auto start = chrono::steady_clock::now();
+        ZReport report = generateZReport(today, ORDERS_PATH, CHECKPOINT_PATH);
+
+        elapsed += chrono::duration<double, milli>(
+                       chrono::steady_clock::now() - start)
+                       .count();
+        orderCount = report.getOrderCount();
+    }
+
+    remove(ORDERS_PATH);
+
+    cout << "z-report of " << orderCount << " orders in a file of "
+         << DAYS * ORDERS_PER_DAY << " rows: " << elapsed / RUNS << " ms"
+         << endl;
+
+    return orderCount == ORDERS_PER_DAY ? 0 : 1;
+}
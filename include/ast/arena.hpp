@@ -0,0 +1,134 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <algorithm>
+#include <ast/pool.hpp>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ *
+ * Size of the blocks nodes are carved out of. A view of the
+ * app fits in one.
+ */
+const size_t NODE_ARENA_BLOCK_SIZE = 64 * 1024;
+
+/**
+ *
+ * Bump allocator for the nodes of a view. Objects are never
+ * freed one by one, `reset()` destroys all of them at once and
+ * keeps the blocks around for the next view. The types in
+ * `isPooledNode` come from their `NodePool` instead, and go back
+ * to it on `reset()`.
+ */
+class NodeArena {
+   private:
+    /**
+     *
+     * Put in front of every object so the arena can run its
+     * destructor on `reset()`, newest first.
+     */
+    struct ObjectHeader {
+        void (*destroy)(void*);
+        void* object;
+        ObjectHeader* prev;
+    };
+
+    struct Block {
+        unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+
+    vector<Block> blocks;
+    size_t blockSize;
+    size_t currentBlock;
+    size_t offset;
+
+    ObjectHeader* lastObject;
+    size_t objectCount;
+
+   private:
+    void* allocate(size_t, size_t);
+
+    template <typename T>
+    static void destroy(void* object) {
+        static_cast<T*>(object)->~T();
+    }
+
+    template <typename T>
+    static void recycle(void* object) {
+        getNodePools().get<T>().release(static_cast<T*>(object));
+    }
+
+   public:
+    NodeArena();
+    NodeArena(size_t);
+    ~NodeArena();
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+   public:
+    /**
+     *
+     * Constructs a `T` inside the arena. The pointer stays valid
+     * until the next `reset()`.
+     */
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        if constexpr (isPooledNode<T>) {
+            T* object =
+                getNodePools().get<T>().acquire(forward<Args>(args)...);
+            ObjectHeader* header = new (
+                allocate(sizeof(ObjectHeader), alignof(ObjectHeader)))
+                ObjectHeader{recycle<T>, object, lastObject};
+
+            lastObject = header;
+            ++objectCount;
+
+            return object;
+        }
+
+        size_t objectOffset =
+            (sizeof(ObjectHeader) + alignof(T) - 1) / alignof(T) * alignof(T);
+        size_t align = max(alignof(T), alignof(ObjectHeader));
+        unsigned char* memory = static_cast<unsigned char*>(
+            allocate(objectOffset + sizeof(T), align));
+        T* object = new (memory + objectOffset) T(forward<Args>(args)...);
+        ObjectHeader* header =
+            new (memory) ObjectHeader{destroy<T>, object, lastObject};
+
+        lastObject = header;
+        ++objectCount;
+
+        return object;
+    }
+
+    /**
+     *
+     * Destroys every object made since the last reset, or gives
+     * it back to its pool.
+     */
+    void reset() noexcept;
+    void swap(NodeArena&) noexcept;
+
+    size_t getObjectCount() const noexcept;
+    size_t getBlockCount() const noexcept;
+};
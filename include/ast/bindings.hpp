@@ -0,0 +1,91 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+class Node;
+class InteractableNode;
+
+/**
+ *
+ * Index of a focus scope in a `KeyBindingTable`
+ */
+using FocusScopeId = uint16_t;
+
+/** Scope of the whole view, every other one is under it */
+const FocusScopeId ROOT_FOCUS_SCOPE = 0;
+
+/**
+ *
+ * The interactable nodes of a view by the key codes they take,
+ * built once per view so a key goes straight to its nodes
+ * instead of down the whole tree.
+ *
+ * Nodes are bound in a focus scope. A key goes to the nodes bound
+ * to it in the focused scope, and only if none of them took it,
+ * on to the scope around that one. Nodes in scopes that are
+ * neither focused nor around the focused one don't get it.
+ */
+class KeyBindingTable {
+   private:
+    struct KeyBinding {
+        InteractableNode *node;
+        FocusScopeId scope;
+    };
+
+    /** Indexed by key code, in the order the nodes were bound */
+    vector<vector<KeyBinding>> bindings;
+    /** Indexed by `FocusScopeId` */
+    vector<FocusScopeId> scopeParents;
+    FocusScopeId focusedScope;
+    /**
+     *
+     * Bindings of the key being dispatched, kept so dispatching
+     * doesn't allocate once it has seen the busiest key
+     */
+    vector<KeyBinding> dispatchedTargets;
+
+   public:
+    KeyBindingTable();
+
+   public:
+    /**
+     *
+     * Drops every binding and scope but the root one, and focuses
+     * it. Keeps the memory for the next view.
+     */
+    void clear() noexcept;
+    /** New scope inside the given one */
+    FocusScopeId openScope(FocusScopeId);
+    void focus(FocusScopeId) noexcept;
+    FocusScopeId getFocusedScope() const noexcept;
+
+    void bind(unsigned int, InteractableNode *, FocusScopeId);
+    /**
+     *
+     * Binds every interactable node under the given one, in the
+     * order they are painted
+     */
+    void bindTree(const Node *, FocusScopeId);
+
+    /**
+     *
+     * Hands the key to the nodes bound to it. Returns whether one
+     * of them took it.
+     */
+    bool dispatch(unsigned int);
+};
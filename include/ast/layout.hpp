@@ -0,0 +1,423 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+class Node;
+class SpatialIndex;
+class WorkStealingPool;
+
+/**
+ *
+ * Index of a node in the `LayoutStore`
+ */
+using NodeHandle = uint32_t;
+
+const NodeHandle NO_NODE = numeric_limits<NodeHandle>::max();
+
+/**
+ *
+ * How a node sizes itself and places its children.
+ *
+ * FLOW_LAYOUT: children flow like text. Blocks take a line of
+ * their own and inlines are put side by side until they overflow.
+ * GRID_LAYOUT: children are put left to right, `colGap` apart,
+ * and wrap to the next row once they overflow the grid's width.
+ * TEXT_LAYOUT: wraps `textSize` characters in the width given,
+ * or its `textLines` if it has any.
+ * FLEX_LAYOUT: children are put in rows, `colGap` apart, starting
+ * at their `flexBasis`. Each row hands its free space out by
+ * `flexGrow`, or takes what it overflows by back by `flexShrink`.
+ * LIST_LAYOUT: `preferredHeight` rows of at most `textSize`
+ * characters. Rows that don't fit are cut, not wrapped.
+ */
+enum LayoutKind : uint8_t {
+    FLOW_LAYOUT,
+    GRID_LAYOUT,
+    TEXT_LAYOUT,
+    FLEX_LAYOUT,
+    LIST_LAYOUT
+};
+
+enum LayoutFlags : uint16_t {
+    /** The node itself has to be measured again */
+    LAYOUT_DIRTY = 1 << 0,
+    /** Some node under this one has to be measured again */
+    CHILD_LAYOUT_DIRTY = 1 << 1,
+    /** Measured since the last arrange */
+    ARRANGE_DIRTY = 1 << 2,
+    /** The node and everything under it has to be painted again */
+    PAINT_DIRTY = 1 << 3,
+    /** Some node under this one has to be painted again */
+    CHILD_PAINT_DIRTY = 1 << 4,
+    /** `painted*` holds the area covered by the last paint */
+    PAINTED = 1 << 5,
+    /** Rendered as `NodeRenderStyle::INLINE` */
+    INLINE_STYLE = 1 << 6,
+    /** Grid whose children take the remaining width */
+    FLEXIBLE_GRID = 1 << 7,
+    /** Flex container that starts a new row instead of shrinking */
+    FLEX_WRAP = 1 << 8,
+    /** `contentHash` is up to date */
+    CONTENT_HASHED = 1 << 9,
+    /** Part of a tree kept in a `SpatialIndex` */
+    SPATIALLY_INDEXED = 1 << 10
+};
+
+/**
+ *
+ * Byte range of one line of a wrapped text
+ */
+struct TextLine {
+    uint32_t begin;
+    uint32_t end;
+};
+
+/**
+ *
+ * A text broken into lines at word boundaries, never inside a
+ * UTF-8 sequence. Words longer than a line are cut. Kept by the
+ * node that owns the text, and only wrapped again once the text
+ * or the width changes.
+ */
+class TextLines {
+   private:
+    const string *text;
+    bool isWrapped;
+    unsigned int wrappedWidth;
+    vector<TextLine> lines;
+    bool isHashed;
+    size_t textHash;
+
+   public:
+    TextLines(const string *);
+
+   public:
+    /**
+     *
+     * Lines of the text in the given number of columns
+     */
+    const vector<TextLine> &wrap(unsigned int);
+    /**
+     *
+     * Has to be called whenever the text changes
+     */
+    void invalidate() noexcept;
+    size_t getTextHash() noexcept;
+};
+
+/**
+ *
+ * Subtrees the measure cache holds at most before it is emptied
+ */
+const size_t MEASURE_CACHE_CAPACITY = 256;
+
+/**
+ *
+ * Nodes a run of siblings needs before it is measured on a thread
+ * of its own
+ */
+const uint32_t PARALLEL_MEASURE_MIN_NODES = 1024;
+
+struct MeasureCacheStats {
+    size_t hits;
+    size_t misses;
+
+    /** 0 if the cache was never looked up */
+    double hitRate() const noexcept;
+};
+
+/**
+ *
+ * Geometry and links of every node, one array per field and
+ * indexed by `NodeHandle`, so the layout passes walk contiguous
+ * memory and switch on `kind` instead of calling virtuals.
+ * `Node` is a façade over its slot.
+ *
+ * Handles of destroyed nodes are reused, so the nodes of a view
+ * built after the previous one was freed end up next to
+ * each other.
+ */
+class LayoutStore {
+   public:
+    vector<Node*> nodes;
+    vector<LayoutKind> kind;
+    vector<uint16_t> flags;
+
+    vector<NodeHandle> parent;
+    vector<NodeHandle> firstChild;
+    vector<NodeHandle> lastChild;
+    vector<NodeHandle> prevSibling;
+    vector<NodeHandle> nextSibling;
+    vector<uint32_t> childCount;
+    /**
+     *
+     * Nodes in the subtree, the node itself included. Counted by
+     * `layout()` only while measuring may go parallel.
+     */
+    vector<uint32_t> subtreeSize;
+
+    vector<unsigned int> posX;
+    vector<unsigned int> posY;
+    /** Position relative to the parent, set while measuring */
+    vector<unsigned int> offsetX;
+    vector<unsigned int> offsetY;
+    vector<unsigned int> width;
+    vector<unsigned int> height;
+    /** Asked for with `setWidth()`/`setHeight()`, 0 for none */
+    vector<unsigned int> preferredWidth;
+    vector<unsigned int> preferredHeight;
+    /**
+     *
+     * Width the node was last measured in. A clean node measured
+     * in the same width again keeps its size.
+     */
+    vector<unsigned int> measuredInWidth;
+
+    vector<unsigned int> colGap;
+    vector<unsigned int> rowGap;
+    vector<unsigned int> childWidth;
+    vector<unsigned int> textSize;
+    /**
+     *
+     * Where text nodes keep their lines, so they are measured as
+     * tall as they are wrapped. nullptr for other nodes.
+     */
+    vector<TextLines *> textLines;
+
+    /** Share of a flex row's free space the node takes */
+    vector<unsigned int> flexGrow;
+    /** Weighed by the node's size, how much of an overflow it gives */
+    vector<unsigned int> flexShrink;
+    /** Width the node starts with in a flex row, 0 for its own */
+    vector<unsigned int> flexBasis;
+
+    /**
+     *
+     * Hash of everything the layout of the node's subtree
+     * depends on. Valid while `CONTENT_HASHED` is set.
+     */
+    vector<uint64_t> contentHash;
+
+    vector<unsigned int> paintedX;
+    vector<unsigned int> paintedY;
+    vector<unsigned int> paintedWidth;
+    vector<unsigned int> paintedHeight;
+
+    /**
+     *
+     * Stamp of the node's entries in the `SpatialIndex` of its
+     * tree, 0 if it has none
+     */
+    vector<uint32_t> indexStamp;
+    /** First band of the index the node is filed in */
+    vector<unsigned int> indexedBand;
+    vector<unsigned int> indexedBandCount;
+
+    vector<NodeHandle> freeHandles;
+
+   private:
+    /**
+     *
+     * What `measure()` left in one node of a cached subtree
+     */
+    struct CachedGeometry {
+        uint64_t contentHash;
+        unsigned int width;
+        unsigned int height;
+        unsigned int offsetX;
+        unsigned int offsetY;
+        unsigned int measuredInWidth;
+    };
+
+    /**
+     *
+     * Geometry of a whole subtree, in preorder, measured in
+     * `availableWidth`
+     */
+    struct MeasureCacheEntry {
+        uint64_t contentHash;
+        unsigned int availableWidth;
+        vector<CachedGeometry> subtree;
+    };
+
+    unordered_map<uint64_t, MeasureCacheEntry> measureCache;
+    MeasureCacheStats measureCacheStats;
+    bool isMeasureCacheEnabled;
+    /**
+     *
+     * Taken for the measure cache and its stats, only while runs
+     * forked onto `measurePool` may be measuring
+     */
+    mutex measureCacheLock;
+    bool isMeasuringInParallel;
+
+    /** Started by the first `layout()` of a tree big enough */
+    unique_ptr<WorkStealingPool> measurePool;
+    size_t measureThreadCount;
+    uint32_t parallelMeasureMinNodes;
+
+    /** By the handle of the tree's root */
+    unordered_map<NodeHandle, unique_ptr<SpatialIndex>> spatialIndexes;
+    /** Index of the tree `layout()` is arranging, if it has one */
+    SpatialIndex *arrangedIndex;
+
+   private:
+    uint64_t hashContent(NodeHandle) noexcept;
+    /**
+     *
+     * Gives the node's subtree the geometry of an identical one
+     * measured in the same width before. Returns false on a miss.
+     */
+    bool restoreMeasured(NodeHandle, unsigned int);
+    void cacheMeasured(NodeHandle, unsigned int);
+
+    /** Index of the tree the node is in, or nullptr */
+    SpatialIndex *findSpatialIndex(NodeHandle) const noexcept;
+    /** For subtrees taken out of an indexed tree */
+    void unfileSubtree(NodeHandle) noexcept;
+
+    void measureFlow(NodeHandle, unsigned int) noexcept;
+    void measureGrid(NodeHandle, unsigned int) noexcept;
+    void measureText(NodeHandle, unsigned int) noexcept;
+    void measureFlex(NodeHandle, unsigned int) noexcept;
+    void measureList(NodeHandle, unsigned int) noexcept;
+    /**
+     *
+     * Width a flex item starts with before its row grows or
+     * shrinks it
+     */
+    unsigned int flexBaseSize(NodeHandle, unsigned int) noexcept;
+
+    /**
+     *
+     * Measures the dirty children in the given width ahead of the
+     * layout that places them, with runs of siblings big enough
+     * forked onto `measurePool`. Returns once all of them are
+     * measured. Only for layouts whose children don't depend on
+     * each other's size to be measured.
+     */
+    void measureChildrenInParallel(NodeHandle, unsigned int) noexcept;
+    /**
+     *
+     * Counts the nodes in the dirty parts of the subtree, or in all
+     * of it when recounting
+     */
+    uint32_t countSubtree(NodeHandle, bool = false) noexcept;
+    /** Measures the siblings from the first up to the second */
+    void measureRun(NodeHandle, NodeHandle, unsigned int) noexcept;
+    /** Flags the node and its ancestors as having a dirty node under them */
+    void markChildPaintDirty(NodeHandle) noexcept;
+
+   public:
+    LayoutStore();
+    ~LayoutStore();
+
+   public:
+    NodeHandle create(Node*, LayoutKind);
+    void release(NodeHandle) noexcept;
+    size_t size() const noexcept;
+
+    void appendChild(NodeHandle, NodeHandle) noexcept;
+    void removeChild(NodeHandle, NodeHandle) noexcept;
+    void removeAllChildren(NodeHandle) noexcept;
+    NodeHandle getChildAt(NodeHandle, size_t) const noexcept;
+
+    /**
+     *
+     * Bottom-up pass. Skipped for nodes that are clean and were
+     * measured in the same width before.
+     */
+    void measure(NodeHandle, unsigned int) noexcept;
+    /**
+     *
+     * Top-down pass. Moves the node to the given position and its
+     * children to where `measure()` placed them. Skips subtrees
+     * that neither moved nor were measured again.
+     */
+    void arrange(NodeHandle, unsigned int, unsigned int) noexcept;
+    /**
+     *
+     * Re-measures the dirty nodes under this one in the width they
+     * were last given, deepest first. Returns whether the node's
+     * size changed, since only then does its parent have to be
+     * measured again too.
+     */
+    bool relayout(NodeHandle) noexcept;
+    /**
+     *
+     * Brings the layout of the tree under the node up to date.
+     * Only the dirty subtrees are measured again, and the
+     * ancestors of one only if its size changed.
+     */
+    void layout(NodeHandle, unsigned int);
+
+    /**
+     *
+     * Flags the node for the next `layout()` and its ancestors as
+     * having a dirty node under them. Stops at the first ancestor
+     * that is flagged already, so building a tree costs one flag
+     * per node.
+     */
+    void markLayoutDirty(NodeHandle) noexcept;
+    void markPaintDirty(NodeHandle) noexcept;
+
+    /**
+     *
+     * A container measured in a width it was measured in before,
+     * with the same `contentHash`, gets its whole subtree's geometry
+     * from the cache instead of being measured again. Leaves are
+     * cheaper to measure than to look up, so they aren't cached.
+     */
+    void setIsMeasureCacheEnabled(bool);
+    MeasureCacheStats getMeasureCacheStats() const noexcept;
+    void resetMeasureCacheStats() noexcept;
+
+    /**
+     *
+     * Threads measuring runs of sibling subtrees of flows and of
+     * grids of fixed cells at once, the thread calling `layout()`
+     * included. 1 measures everything on that thread. Defaults to
+     * the cores there are.
+     */
+    void setMeasureThreadCount(size_t);
+    size_t getMeasureThreadCount() const noexcept;
+    /** `PARALLEL_MEASURE_MIN_NODES` by default */
+    void setParallelMeasureMinNodes(uint32_t) noexcept;
+
+    /**
+     *
+     * Keeps the tree under the root in a `SpatialIndex`, which
+     * `layout()` keeps up to date from then on, or drops it
+     */
+    void setIsSpatiallyIndexed(NodeHandle, bool);
+    /** nullptr unless the node is the root of an indexed tree */
+    const SpatialIndex *getSpatialIndex(NodeHandle) const noexcept;
+};
+
+LayoutStore& getLayoutStore() noexcept;
+/**
+ *
+ * Has to come before any node is made
+ */
+void initializeLayoutStore();
@@ -12,16 +12,19 @@
 #endif
 
 #include <algorithm>
+#include <ast/bindings.hpp>
+#include <ast/layout.hpp>
+#include <ast/style.hpp>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
-#include <functional>
+#include <delegate.hpp>
 #include <memory>
 #include <optional>
 #include <screen.hpp>
-#include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utils.hpp>
 #include <vector>
@@ -32,27 +35,39 @@ using namespace terminal;
 
 enum NodeTypes { CONTAINER, INTERACTABLE, LEAF };
 enum NodeRenderStyle { BLOCK, INLINE };
-enum TextNodeFormats { BOLD, ITALIC, UNDERLINE, STRIKETHROUGH, DIM };
-
-class Node : public enable_shared_from_this<Node> {
+enum TableColumnAlign { LEFT_ALIGN, RIGHT_ALIGN };
+
+/**
+ *
+ * Nodes don't own each other. They are made in a `NodeArena`
+ * that frees the whole tree at once.
+ *
+ * A node's geometry and its links to its parent, children and
+ * siblings live in its slot of the `LayoutStore`, which does the
+ * layout passes. The node itself only keeps what it needs to
+ * render and handle keys.
+ */
+class Node {
    public:
-    using NodePtr = shared_ptr<Node>;
+    using NodePtr = Node *;
 
    private:
-    NodePtr parent;
-    unsigned int posX;
-    unsigned int posY;
-
-   protected:
-    vector<NodePtr> children;
-    unsigned int width;
-    unsigned int height;
+    NodeHandle handle;
+    /**
+     *
+     * Tells apart siblings of the same type when a view is
+     * reconciled. Empty for nodes matched by position only.
+     */
+    string key;
 
    public:
     Node();
     Node(unsigned int);
     Node(unsigned int, unsigned int);
 
+    Node(const Node &) = delete;
+    Node &operator=(const Node &) = delete;
+
    public:
     virtual void render(ostringstream *) const = 0;
     virtual NodeTypes nodeType() const noexcept = 0;
@@ -61,9 +76,46 @@ class Node : public enable_shared_from_this<Node> {
      *
      * Default is `NodeRenderStyle::BLOCK`
      */
-    virtual NodeRenderStyle nodeRenderStyle() const noexcept;
+    NodeRenderStyle nodeRenderStyle() const noexcept;
     virtual bool canHaveChildren() const noexcept;
 
+    NodeHandle getHandle() const noexcept;
+
+    const string &getKey() const noexcept;
+    void setKey(const string &);
+
+    /**
+     *
+     * Copies the props of `node`, which has the same type as this
+     * one, flagging only what changed for layout or painting.
+     * Children are left alone.
+     */
+    virtual void patchFrom(const Node &);
+
+    /**
+     *
+     * Used by `NodePool`. `recycle()` gives the node's slot back
+     * to the `LayoutStore` once its view is freed, but keeps the
+     * memory of its strings. `reuse()` takes a new slot, and in
+     * the pooled subclasses the same props as their constructors.
+     */
+    void recycle() noexcept;
+    void reuse();
+
+    /**
+     *
+     * How the node is sized inside a `FlexNode`. See
+     * `LayoutKind::FLEX_LAYOUT`.
+     */
+    unsigned int getFlexGrow() const noexcept;
+    void setFlexGrow(unsigned int);
+
+    unsigned int getFlexShrink() const noexcept;
+    void setFlexShrink(unsigned int);
+
+    unsigned int getFlexBasis() const noexcept;
+    void setFlexBasis(unsigned int);
+
     virtual unsigned int getWidth() const noexcept;
     virtual void setWidth(unsigned int);
 
@@ -77,33 +129,83 @@ class Node : public enable_shared_from_this<Node> {
     virtual void setPosY(unsigned int);
 
     virtual NodePtr getParent() const noexcept;
-    virtual const vector<NodePtr> &getChildren() const noexcept;
+    NodePtr getFirstChild() const noexcept;
+    NodePtr getLastChild() const noexcept;
+    NodePtr getPrevSibling() const noexcept;
+    NodePtr getNextSibling() const noexcept;
+    size_t getChildCount() const noexcept;
+    /**
+     *
+     * Walks the siblings, so prefer `getFirstChild()` and
+     * `getNextSibling()` when visiting every child.
+     */
+    NodePtr getChildAt(size_t) const;
 
     virtual ~Node();
 
    private:
     /**
      *
-     * Default behavior:
-     * Adjusts width and height based on child with largest width
-     * and latest child's height (to be inserted).
-     * Basically depends on child to define its dimensions
-     * unlike a grid container.
+     * Called after the child at `idx` is removed. The layout
+     * is already marked dirty by then.
      */
     virtual void onChildRemoved(size_t, NodePtr);
+
+   private:
+    void eraseStalePaint(ostringstream *) const;
+    void paintDirtyNodes(ostringstream *);
+    void markPainted() noexcept;
+    void markFlexItemDirty() noexcept;
+
+   protected:
     /**
      *
-     * Default behavior:
-     * Adjusts width and height based on child with largest width
-     * and latest child's height (to be inserted).
-     * Basically depends on child to define its dimensions
-     * unlike a grid container.
+     * Picks how the `LayoutStore` measures the node.
+     * Default is `LayoutKind::FLOW_LAYOUT`.
      */
-    virtual void onChildAppended();
+    void setLayoutKind(LayoutKind) noexcept;
+    void setNodeRenderStyle(NodeRenderStyle) noexcept;
 
    public:
-    virtual void updateParentDimensionsOnChildChange(NodePtr);
-    virtual void updateChildrenDimensionsOnChange();
+    /**
+     *
+     * Brings the layout up to date. Meant to be called on the root
+     * before it is painted. Only the dirty subtrees are measured
+     * again, and the ancestors of one only if its size changed.
+     */
+    void layout(unsigned int);
+    /**
+     *
+     * Erases and redraws only the subtrees flagged for painting.
+     */
+    void paint(ostringstream *);
+
+    /**
+     *
+     * Keeps the tree under this root in a `SpatialIndex`, which
+     * `layout()` keeps up to date, so `hitTest()` and
+     * `findNodesIn()` only look at the rows they are asked about
+     */
+    void setIsSpatiallyIndexed(bool);
+    /**
+     *
+     * Deepest node of the indexed tree at the cell, or nullptr
+     * if there is none or the tree isn't indexed
+     */
+    NodePtr hitTest(unsigned int, unsigned int) const;
+    /**
+     *
+     * Appends the nodes of the indexed tree covering a cell of the
+     * region at (col, row) of the given width and height
+     */
+    void findNodesIn(unsigned int, unsigned int, unsigned int, unsigned int,
+                     vector<NodePtr> &) const;
+
+    bool isLayoutDirty() const noexcept;
+    void markLayoutDirty() noexcept;
+
+    bool isPaintDirty() const noexcept;
+    void markPaintDirty() noexcept;
 
    public:
     /**
@@ -112,7 +214,6 @@ class Node : public enable_shared_from_this<Node> {
      * Node type
      */
     virtual void assertChildIsValid(NodePtr) const;
-    virtual void setAsParentOfChild(NodePtr);
     virtual void appendChild(NodePtr);
     virtual void removeChildAt(size_t);
     virtual void removeAllChildren() noexcept;
@@ -125,19 +226,12 @@ class ContainerNode : public Node {
         NodeTypes nodeType() const noexcept override;
 };
 
+/**
+ *
+ * Children are put left to right, `colGap` apart, and wrap to
+ * the next row once they overflow the grid's width.
+ */
 class GridNode : public ContainerNode {
-   private:
-    unsigned int colGap;
-    unsigned int rowGap;
-
-    unsigned int childWidth;
-
-    /**
-     *
-     * Whether to have its children take remaining width
-     */
-    bool flexible;
-
    public:
     GridNode();
     GridNode(unsigned int);
@@ -146,24 +240,59 @@ class GridNode : public ContainerNode {
     GridNode(unsigned int, unsigned int, unsigned int, unsigned int);
 
    public:
-    virtual void removeAllChildren() noexcept override;
-    virtual void onChildAppended() override;
-    virtual void onChildRemoved(size_t, NodePtr) override;
-
-    virtual void updateChildrenDimensionsOnChange() override;
-    virtual void updateParentDimensionsOnChildChange(
-        NodePtr childCaller) override;
+    virtual void patchFrom(const Node &) override;
+    void reuse();
+    void reuse(unsigned int, unsigned int = 0, unsigned int = 4,
+               unsigned int = 2);
 
+   public:
     unsigned int getColGap() const noexcept;
     void setColGap(unsigned int);
 
     unsigned int getRowGap() const noexcept;
     void setRowGap(unsigned int);
 
+    /**
+     *
+     * Whether to have its children take remaining width
+     */
     bool isFlexible() const noexcept;
     void setIsFlexible(bool) noexcept;
 };
 
+/**
+ *
+ * Puts its children in rows like a CSS flexbox does. Each child
+ * starts at its flex basis, or its own width if it has none, then
+ * the row's free space is handed out by flex grow, or what it
+ * overflows by is taken back by flex shrink. Rows are solved in a
+ * single pass each.
+ */
+class FlexNode : public ContainerNode {
+   public:
+    FlexNode();
+    FlexNode(unsigned int);
+    FlexNode(unsigned int, unsigned int, unsigned int);
+
+   public:
+    virtual void patchFrom(const Node &) override;
+
+   public:
+    unsigned int getColGap() const noexcept;
+    void setColGap(unsigned int);
+
+    unsigned int getRowGap() const noexcept;
+    void setRowGap(unsigned int);
+
+    /**
+     *
+     * Whether to start a new row instead of shrinking the
+     * children when they overflow
+     */
+    bool isWrapping() const noexcept;
+    void setIsWrapping(bool) noexcept;
+};
+
 class LeafNode : public Node {
    public:
     bool canHaveChildren() const noexcept override;
@@ -171,11 +300,14 @@ class LeafNode : public Node {
 };
 
 class TextNode : public LeafNode {
+    friend class SelectOptionNode;
+
    private:
     string text;
-    set<TextNodeFormats> formats;
-    optional<tuple<uint8_t, uint8_t, uint8_t>> color;
-    optional<tuple<uint8_t, uint8_t, uint8_t>> backgroundColor;
+    /** `text` wrapped in the node's width */
+    mutable TextLines lines{&text};
+    /** Interned in the `TextStyleTable` */
+    TextStyleId styleId = PLAIN_TEXT_STYLE;
 
    public:
     TextNode(string);
@@ -184,27 +316,35 @@ class TextNode : public LeafNode {
     TextNode(string, unsigned int, unsigned int, unsigned int);
     TextNode(string, unsigned int, unsigned int, unsigned int, unsigned int);
 
-   public:
-    virtual NodeRenderStyle nodeRenderStyle() const noexcept override;
-
    public:
     virtual void render(ostringstream *) const override;
+    virtual void patchFrom(const Node &) override;
+    void recycle() noexcept;
+    /** A width of 0 leaves the width to the text */
+    void reuse(string_view, unsigned int = 0, unsigned int = 0,
+               unsigned int = 0, unsigned int = 1);
 
    public:
     virtual void setWidth(unsigned int w) override;
     virtual void setHeight(unsigned int h) override;
 
+    string getText() const noexcept;
+    void setText(string);
+
+    TextStyle getStyle() const noexcept;
+    void setStyle(TextStyle);
+
     void setRedColor(uint8_t);
     void setGreenColor(uint8_t);
     void setBlueColor(uint8_t);
     void setColor(uint8_t, uint8_t, uint8_t);
-    void resetColor() noexcept;
+    void resetColor();
 
     void setRedBackgroundColor(uint8_t);
     void setGreenBackgroundColor(uint8_t);
     void setBlueBackgroundColor(uint8_t);
     void setBackgroundColor(uint8_t, uint8_t, uint8_t);
-    void resetBackgroundColor() noexcept;
+    void resetBackgroundColor();
 
     void setBold();
     void removeBold();
@@ -233,6 +373,7 @@ class LineBreakNode : public LeafNode {
 
    public:
     virtual void render(ostringstream *) const override;
+    void reuse(unsigned int = 1, unsigned int = 0, unsigned int = 0);
 };
 
 class SelectOptionNode : public TextNode {
@@ -248,7 +389,9 @@ class SelectOptionNode : public TextNode {
                      unsigned int);
 
    public:
-    NodeRenderStyle nodeRenderStyle() const noexcept override;
+    virtual void patchFrom(const Node &) override;
+    void reuse(string_view, unsigned int = 0, unsigned int = 0,
+               unsigned int = 0, unsigned int = 1);
 
    public:
     string getValue() const noexcept;
@@ -265,21 +408,33 @@ class InteractableNode : public Node {
      * trigger.
      */
     virtual bool onKeyPressed(unsigned int);
+    /**
+     *
+     * Binds the keys `onKeyPressed()` takes. Nodes that take none
+     * don't bind anything.
+     */
+    virtual void bindKeys(KeyBindingTable &, FocusScopeId);
     NodeTypes nodeType() const noexcept override;
 };
 
 class SelectNode : public InteractableNode {
    public:
-    using SubscriberCallback = function<void(optional<string>)>;
+    using SubscriberCallback = Delegate<void(optional<string>)>;
 
    private:
     size_t activeOptionIdx;
 
-    vector<SubscriberCallback> subscribers;
+    Signal<optional<string>> subscribers;
 
    private:
     void selectNext() noexcept;
     void selectPrevious() noexcept;
+    /**
+     *
+     * Highlights the active option and gives the others the plain
+     * style, so painting only has to draw them
+     */
+    void styleOptions() noexcept;
 
     void notify();
 
@@ -290,18 +445,21 @@ class SelectNode : public InteractableNode {
 
    public:
     void render(ostringstream *) const override;
-    void subscribe(SubscriberCallback);
-    void unsubscribe(SubscriberCallback);
+    void patchFrom(const Node &) override;
+    Connection subscribe(SubscriberCallback);
+    void unsubscribe(Connection) noexcept;
 
-   public:
+   private:
     void onChildRemoved(size_t, NodePtr) override;
 
    public:
     void assertChildIsValid(NodePtr) const override;
+    void appendChild(NodePtr) override;
 
    public:
     void resetActiveIdx() noexcept;
     virtual bool onKeyPressed(unsigned int) override;
+    virtual void bindKeys(KeyBindingTable &, FocusScopeId) override;
 
    public:
     optional<string> getValueOfSelectedOption() const;
@@ -314,9 +472,165 @@ class SelectNode : public InteractableNode {
     void setActiveChildWithValue(string);
 };
 
+/**
+ *
+ * A selectable list that only lays out and renders the rows in
+ * its window, which scrolls to keep the active row in view. Rows
+ * are pulled from `rowSource` when they come into the window, so
+ * the cost of scrolling depends on how many rows are visible,
+ * not on how many there are.
+ */
+class VirtualListNode : public InteractableNode {
+   public:
+    /** Text of the row at the given index */
+    using RowSource = Delegate<string(size_t)>;
+    using SubscriberCallback = Delegate<void(size_t)>;
+
+   private:
+    size_t rowCount;
+    RowSource rowSource;
+    size_t activeRowIdx;
+    size_t firstVisibleRowIdx;
+    unsigned int visibleRowCount;
+    /**
+     *
+     * Rows in the window, pulled from `rowSource` whenever
+     * the window moves
+     */
+    vector<string> visibleRows;
+
+    Signal<size_t> subscribers;
+
+   private:
+    void selectNext() noexcept;
+    void selectPrevious() noexcept;
+    /**
+     *
+     * Moves the window as little as needed for the active
+     * row to be in it. Returns whether it moved.
+     */
+    bool scrollToActiveRow() noexcept;
+    void fetchVisibleRows();
+
+    void notify();
+
+   public:
+    /**
+     *
+     * Shows as many rows as fit the screen's height
+     */
+    VirtualListNode(size_t, RowSource);
+    VirtualListNode(size_t, RowSource, unsigned int);
+    ~VirtualListNode();
+
+   public:
+    void render(ostringstream *) const override;
+    void patchFrom(const Node &) override;
+    Connection subscribe(SubscriberCallback);
+    void unsubscribe(Connection) noexcept;
+
+   public:
+    virtual bool onKeyPressed(unsigned int) override;
+    virtual void bindKeys(KeyBindingTable &, FocusScopeId) override;
+    virtual bool canHaveChildren() const noexcept override;
+
+   public:
+    size_t getRowCount() const noexcept;
+
+    size_t getActiveRowIdx() const noexcept;
+    /**
+     *
+     * Scrolls the row into view. Subscribers aren't notified.
+     */
+    void setActiveRowIdx(size_t);
+
+    size_t getFirstVisibleRowIdx() const noexcept;
+
+    unsigned int getVisibleRowCount() const noexcept;
+    void setVisibleRowCount(unsigned int);
+};
+
+/**
+ *
+ * Rows of cells under a header row. Each column is as wide as its
+ * widest cell, from display widths worked out once when a row is
+ * appended. Like `VirtualListNode`, only the rows in its window
+ * are rendered, and up/down scroll it.
+ */
+class TableNode : public InteractableNode {
+   private:
+    vector<TableColumnAlign> columnAligns;
+    /** Widest cell of each column, the header included */
+    vector<unsigned int> columnWidths;
+    unsigned int colGap;
+    /** The header row, then every other row, a cell after another */
+    vector<string> cells;
+    /** Display width of each of the `cells` */
+    vector<unsigned int> cellWidths;
+    size_t firstVisibleRowIdx;
+    unsigned int visibleRowCount;
+
+   private:
+    /**
+     *
+     * Sizes the node to its columns and the rows in its window
+     */
+    void fitContent() noexcept;
+    /**
+     *
+     * Keeps the window from going past the last row
+     */
+    void clampScroll() noexcept;
+    void renderRow(ostringstream *, size_t, unsigned int) const;
+
+   public:
+    /**
+     *
+     * Shows as many rows as fit the screen's height
+     */
+    TableNode(vector<string>);
+    TableNode(vector<string>, unsigned int);
+
+   public:
+    void render(ostringstream *) const override;
+    void patchFrom(const Node &) override;
+
+   public:
+    virtual bool onKeyPressed(unsigned int) override;
+    virtual void bindKeys(KeyBindingTable &, FocusScopeId) override;
+    virtual bool canHaveChildren() const noexcept override;
+
+   public:
+    size_t getColumnCount() const noexcept;
+    unsigned int getColumnWidth(size_t) const;
+
+    /**
+     *
+     * Default is `TableColumnAlign::LEFT_ALIGN`. Numbers read
+     * better right-aligned.
+     */
+    void setColumnAlign(size_t, TableColumnAlign);
+
+    unsigned int getColGap() const noexcept;
+    void setColGap(unsigned int);
+
+    /** Not counting the header row */
+    size_t getRowCount() const noexcept;
+    /**
+     *
+     * Takes a cell for each column
+     */
+    void appendRow(vector<string>);
+
+    size_t getFirstVisibleRowIdx() const noexcept;
+
+    unsigned int getVisibleRowCount() const noexcept;
+    void setVisibleRowCount(unsigned int);
+};
+
 class ButtonNode : public InteractableNode {
    public:
-    using SubscriberCallback = function<void(unsigned int)>;
+    using SubscriberCallback = Delegate<void(unsigned int)>;
 
    private:
     /** utf-8 string */
@@ -327,9 +641,14 @@ class ButtonNode : public InteractableNode {
      * A {lowercase, uppercase} keyCode tuple
      */
     tuple<unsigned int, unsigned int> keyCode;
+    /**
+     *
+     * Drawn highlighted. Set by the view, not by key presses,
+     * so what is on screen always matches it.
+     */
     bool isPressed;
 
-    vector<SubscriberCallback> subscribers;
+    Signal<unsigned int> subscribers;
 
    public:
     ButtonNode(string, string, tuple<unsigned int, unsigned int>);
@@ -340,8 +659,12 @@ class ButtonNode : public InteractableNode {
 
    public:
     virtual void render(ostringstream *) const override;
-    void subscribe(SubscriberCallback);
-    void unsubscribe(SubscriberCallback);
+    virtual void patchFrom(const Node &) override;
+    void recycle() noexcept;
+    void reuse(string_view, string_view, tuple<unsigned int, unsigned int>,
+               bool = false);
+    Connection subscribe(SubscriberCallback);
+    void unsubscribe(Connection) noexcept;
 
    public:
     virtual void setWidth(unsigned int w) override;
@@ -354,5 +677,6 @@ class ButtonNode : public InteractableNode {
      * trigger.
      */
     virtual bool onKeyPressed(unsigned int) override;
+    virtual void bindKeys(KeyBindingTable &, FocusScopeId) override;
     virtual bool canHaveChildren() const noexcept override;
 };
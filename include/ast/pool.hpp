@@ -0,0 +1,130 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <ast/node.hpp>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ *
+ * Nodes of one type kept once the view they were in is freed,
+ * and handed out again for the next one along with the memory
+ * of their strings. Once a view of the same shape was built a
+ * few times, building it allocates nothing.
+ */
+template <typename T>
+class NodePool {
+   private:
+    vector<unique_ptr<T>> nodes;
+    vector<T *> freeNodes;
+
+   public:
+    /**
+     *
+     * Takes the same arguments as the constructors of `T`
+     */
+    template <typename... Args>
+    T *acquire(Args &&...args) {
+        if (freeNodes.empty()) {
+            nodes.push_back(make_unique<T>(forward<Args>(args)...));
+            // so that `release()` never has to allocate
+            freeNodes.reserve(nodes.size());
+
+            return nodes.back().get();
+        }
+
+        // arenas free their nodes newest first, so the node made
+        // first in the last view is handed out first, and a view
+        // built like that one gets the same nodes in the same places
+        T *node = freeNodes.back();
+
+        freeNodes.pop_back();
+        node->reuse(forward<Args>(args)...);
+
+        return node;
+    }
+
+    void release(T *node) noexcept {
+        node->recycle();
+        freeNodes.push_back(node);
+    }
+
+    /** Nodes made so far, in use or not */
+    size_t size() const noexcept { return nodes.size(); }
+    size_t getFreeCount() const noexcept { return freeNodes.size(); }
+};
+
+/**
+ *
+ * Types the `NodeArena` takes from a `NodePool` instead of
+ * making them in its blocks. These are what every view is
+ * mostly built of.
+ */
+template <typename T>
+constexpr bool isPooledNode =
+    is_same_v<T, TextNode> || is_same_v<T, GridNode> ||
+    is_same_v<T, ButtonNode> || is_same_v<T, SelectOptionNode> ||
+    is_same_v<T, LineBreakNode>;
+
+class NodePools {
+   public:
+    NodePool<TextNode> textNodes;
+    NodePool<GridNode> gridNodes;
+    NodePool<ButtonNode> buttonNodes;
+    NodePool<SelectOptionNode> selectOptionNodes;
+    NodePool<LineBreakNode> lineBreakNodes;
+
+   public:
+    template <typename T>
+    NodePool<T> &get() noexcept;
+};
+
+template <>
+inline NodePool<TextNode> &NodePools::get<TextNode>() noexcept {
+    return textNodes;
+}
+
+template <>
+inline NodePool<GridNode> &NodePools::get<GridNode>() noexcept {
+    return gridNodes;
+}
+
+template <>
+inline NodePool<ButtonNode> &NodePools::get<ButtonNode>() noexcept {
+    return buttonNodes;
+}
+
+template <>
+inline NodePool<SelectOptionNode> &
+NodePools::get<SelectOptionNode>() noexcept {
+    return selectOptionNodes;
+}
+
+template <>
+inline NodePool<LineBreakNode> &NodePools::get<LineBreakNode>() noexcept {
+    return lineBreakNodes;
+}
+
+NodePools &getNodePools() noexcept;
+/**
+ *
+ * Has to come after `initializeLayoutStore()` and before any
+ * node is made in a `NodeArena`
+ */
+void initializeNodePools();
@@ -0,0 +1,37 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <ast/node.hpp>
+#include <typeinfo>
+
+using namespace std;
+
+/**
+ *
+ * Whether two trees only differ in their nodes' props. That is,
+ * every node has as many children as its counterpart, and the
+ * children match in type and key in the same order.
+ */
+bool haveSameShape(const Node*, const Node*) noexcept;
+
+/**
+ *
+ * Patches the nodes of `retained` with the props of the matching
+ * nodes of `described`, a tree freshly built for the same view,
+ * so only what actually changed gets laid out and painted again.
+ *
+ * Returns false and leaves `retained` untouched if the trees
+ * don't have the same shape, in which case `described` has to
+ * replace it.
+ */
+bool reconcile(Node*, const Node*);
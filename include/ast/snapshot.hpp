@@ -0,0 +1,94 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <ast/bindings.hpp>
+#include <ast/node.hpp>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ *
+ * What a laid out subtree wrote when it was rendered, kept so it
+ * can be written again without walking the subtree. Where the
+ * cursor was moved to is kept apart from the rest of the bytes,
+ * so they can also be written somewhere else than where the
+ * subtree was laid out.
+ */
+class NodeSnapshot {
+   private:
+    struct CursorMove {
+        /** Where the move starts in `bytes` */
+        size_t begin;
+        size_t end;
+        /** From the top left corner of the subtree */
+        unsigned int col;
+        unsigned int row;
+    };
+
+    Node *source;
+    string bytes;
+    vector<CursorMove> cursorMoves;
+    unsigned int posX;
+    unsigned int posY;
+    unsigned int width;
+    unsigned int height;
+
+   public:
+    /**
+     *
+     * Renders the subtree, which has to be laid out already. It
+     * has to outlive the snapshot.
+     */
+    NodeSnapshot(Node *);
+
+    NodeSnapshot(const NodeSnapshot &) = delete;
+    NodeSnapshot &operator=(const NodeSnapshot &) = delete;
+
+   public:
+    Node *getSource() const noexcept;
+    unsigned int getWidth() const noexcept;
+    unsigned int getHeight() const noexcept;
+
+    /**
+     *
+     * Writes the bytes as if the subtree was laid out at the given
+     * column and row
+     */
+    void write(ostringstream *, unsigned int, unsigned int) const;
+};
+
+/**
+ *
+ * Stands in for the subtree of a `NodeSnapshot`, with its size,
+ * and writes the snapshot instead of rendering it. The keys of
+ * the subtree's interactable nodes are bound in its place.
+ */
+class SnapshotNode : public InteractableNode {
+   private:
+    const NodeSnapshot *snapshot;
+
+   public:
+    SnapshotNode(const NodeSnapshot *);
+
+   public:
+    void render(ostringstream *) const override;
+    void patchFrom(const Node &) override;
+
+   public:
+    virtual void bindKeys(KeyBindingTable &, FocusScopeId) override;
+    virtual bool canHaveChildren() const noexcept override;
+};
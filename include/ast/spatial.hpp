@@ -0,0 +1,90 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <ast/layout.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ *
+ * Rows of the screen one bucket of a `SpatialIndex` covers
+ */
+const unsigned int SPATIAL_INDEX_BAND_ROWS = 8;
+
+/**
+ *
+ * The nodes of a laid out tree, filed in buckets of
+ * `SPATIAL_INDEX_BAND_ROWS` rows by the rows they cover, so
+ * finding what is at a cell or in a region only looks at the
+ * nodes of the bands it covers instead of walking the tree.
+ * `LayoutStore::arrange()` files the nodes it places again.
+ *
+ * Filing a node again leaves its old entries behind. They are
+ * told apart by the stamp the node had when they were made, and
+ * swept out once they are half of the entries.
+ */
+class SpatialIndex {
+   private:
+    struct Entry {
+        NodeHandle node;
+        uint32_t stamp;
+    };
+
+    /** Shared by every index, so an entry never outlives its node */
+    static uint32_t nextStamp;
+
+    NodeHandle root;
+    vector<vector<Entry>> bands;
+    size_t entryCount;
+    size_t staleEntryCount;
+
+   private:
+    bool isLive(const LayoutStore &, const Entry &) const noexcept;
+    unsigned int depthOf(const LayoutStore &, NodeHandle) const noexcept;
+    void sweep(const LayoutStore &);
+
+   public:
+    SpatialIndex(NodeHandle);
+
+   public:
+    NodeHandle getRoot() const noexcept;
+
+    /**
+     *
+     * Files the node under the rows it covers now, unless those
+     * fall in the bands it is filed in already. Nodes without an
+     * area are only marked as part of the tree.
+     */
+    void file(LayoutStore &, NodeHandle);
+    /** For nodes taken out of the tree */
+    void unfile(LayoutStore &, NodeHandle) noexcept;
+
+    /**
+     *
+     * Deepest node covering the cell, or `NO_NODE` if there is
+     * none. Children overflowing into each other are told apart
+     * by depth only.
+     */
+    NodeHandle hitTest(const LayoutStore &, unsigned int,
+                       unsigned int) const noexcept;
+    /**
+     *
+     * Appends every node covering a cell of the region at
+     * (col, row) of the given width and height, in no order
+     */
+    void findNodesIn(const LayoutStore &, unsigned int, unsigned int,
+                     unsigned int, unsigned int, vector<NodeHandle> &) const;
+};
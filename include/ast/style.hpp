@@ -0,0 +1,114 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+enum TextNodeFormats { BOLD, ITALIC, UNDERLINE, STRIKETHROUGH, DIM };
+
+/**
+ *
+ * Formats and colors of a text packed in one word. Bits 0-4 are
+ * the `TextNodeFormats`, bit 5 and 6 tell whether there's a
+ * foreground and a background color, and bits 8-31 and 32-55
+ * hold them as RGB.
+ */
+class TextStyle {
+   private:
+    uint64_t bits;
+
+   public:
+    TextStyle() noexcept;
+    explicit TextStyle(uint64_t) noexcept;
+
+   public:
+    uint64_t getBits() const noexcept;
+    bool isPlain() const noexcept;
+
+    bool hasFormat(TextNodeFormats) const noexcept;
+    void addFormat(TextNodeFormats) noexcept;
+    void removeFormat(TextNodeFormats) noexcept;
+    void resetFormats() noexcept;
+
+    bool hasColor() const noexcept;
+    /** Black if there's no color */
+    tuple<uint8_t, uint8_t, uint8_t> getColor() const noexcept;
+    void setColor(uint8_t, uint8_t, uint8_t) noexcept;
+    void resetColor() noexcept;
+
+    bool hasBackgroundColor() const noexcept;
+    /** Black if there's no background color */
+    tuple<uint8_t, uint8_t, uint8_t> getBackgroundColor() const noexcept;
+    void setBackgroundColor(uint8_t, uint8_t, uint8_t) noexcept;
+    void resetBackgroundColor() noexcept;
+
+    /**
+     *
+     * One SGR sequence that sets every format and color of the
+     * style, empty for a plain one
+     */
+    string toSgr() const;
+
+    bool operator==(const TextStyle &) const noexcept;
+    bool operator!=(const TextStyle &) const noexcept;
+};
+
+static_assert(sizeof(TextStyle) == sizeof(uint64_t),
+              "TextStyle has to stay one word");
+
+/**
+ *
+ * Index of a style in the `TextStyleTable`
+ */
+using TextStyleId = uint16_t;
+
+/** Id of the style without formats and colors */
+const TextStyleId PLAIN_TEXT_STYLE = 0;
+
+/**
+ *
+ * Every style in use, kept once. Nodes with the same style share
+ * its id, compare by it, and render its SGR sequence, which is
+ * only built the first time the style is seen. The app only uses
+ * a handful of styles, so they are never freed.
+ */
+class TextStyleTable {
+   private:
+    vector<TextStyle> styles;
+    vector<string> sgrs;
+    unordered_map<uint64_t, TextStyleId> ids;
+
+   public:
+    TextStyleTable();
+
+   public:
+    TextStyleId intern(TextStyle);
+    TextStyle getStyle(TextStyleId) const noexcept;
+    const string &getSgr(TextStyleId) const noexcept;
+    size_t size() const noexcept;
+};
+
+TextStyleTable &getTextStyleTable() noexcept;
+/**
+ *
+ * Has to come before any text node is styled
+ */
+void initializeTextStyleTable();
@@ -0,0 +1,65 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <ast/arena.hpp>
+#include <ast/node.hpp>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+
+using namespace std;
+
+/**
+ *
+ * A `ButtonNode` described at compile time
+ */
+struct ButtonSpec {
+    string_view icon;
+    string_view text;
+    /**
+     *
+     * A {lowercase, uppercase} keyCode tuple. {0, 0} for buttons
+     * that are only a tool tip.
+     */
+    tuple<unsigned int, unsigned int> keyCode;
+    /** Connected once the button is made, unless it is nullptr */
+    void (*onPressed)(unsigned int);
+    bool isPressed;
+};
+
+/**
+ *
+ * A row of buttons described at compile time, like the nav of a
+ * header or the tool tips of a footer. The buttons are a flat
+ * `constexpr` array, so making the row only makes a node for
+ * each and connects its handler, in the order they are in.
+ */
+struct ButtonBarSpec {
+    unsigned int colGap;
+    unsigned int rowGap;
+    const ButtonSpec *buttons;
+    size_t buttonCount;
+};
+
+template <size_t N>
+constexpr ButtonBarSpec buttonBar(unsigned int colGap, unsigned int rowGap,
+                                  const ButtonSpec (&buttons)[N]) noexcept {
+    return {colGap, rowGap, buttons, N};
+}
+
+/**
+ *
+ * A `GridNode` of the given width holding the buttons of `spec`,
+ * made in the arena
+ */
+GridNode *makeButtonBar(NodeArena &, const ButtonBarSpec &, unsigned int);
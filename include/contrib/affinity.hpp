@@ -0,0 +1,83 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <contrib/menu.hpp>
+#include <contrib/storage.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/**
+ *
+ * "Frequently bought together" counts between menu items.
+ *
+ * Items are identified by their index in the catalog the analysis
+ * was created with. Since co-occurrence is symmetric, only the
+ * lower triangle (diagonal included) of the matrix is stored. The
+ * diagonal holds how many orders contain the item at all.
+ */
+class BasketAffinity {
+   private:
+    vector<string> itemNames;
+    unordered_map<string, size_t> itemIds;
+    vector<uint32_t> counts;
+
+    size_t indexOf(size_t, size_t) const noexcept;
+    /**
+     *
+     * Sorted, deduplicated ids of the catalog items in the order.
+     * Items no longer in the catalog are skipped.
+     */
+    void collectItemIds(const Order&, vector<size_t>&) const;
+    void recordInto(vector<uint32_t>&, const vector<size_t>&) const noexcept;
+
+   public:
+    BasketAffinity(const vector<MenuItemData>&);
+
+    /**
+     *
+     * Recounts everything in the file, one thread per chunk.
+     */
+    void build(const string&);
+    void recordOrder(const Order&);
+
+    size_t getItemCount() const noexcept;
+    optional<size_t> getItemId(const string&) const;
+    const string& getItemName(size_t) const;
+
+    uint32_t getOccurrences(size_t) const;
+    uint32_t getCoOccurrences(size_t, size_t) const;
+
+    /**
+     *
+     * Every item id sorted by how likely it is to be bought with
+     * the given basket, i.e. the sum of P(item | basket item).
+     * Ties keep the catalog's order.
+     */
+    vector<size_t> rankByAffinity(const vector<string>&) const;
+};
+
+BasketAffinity& getBasketAffinity() noexcept;
+/**
+ *
+ * Needs the state to be initialized since the menu items
+ * are taken from there.
+ */
+void initializeBasketAffinity();
@@ -0,0 +1,146 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <array>
+#include <cassert>
+#include <contrib/menu.hpp>
+#include <contrib/storage.hpp>
+#include <contrib/utils.hpp>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/**
+ *
+ * Rows per column batch. Must be a multiple of 64 since
+ * selections are stored as 64-bit words.
+ */
+const size_t SALES_CUBE_BATCH_SIZE = 1024;
+const size_t SALES_CUBE_SELECTION_WORDS = SALES_CUBE_BATCH_SIZE / 64;
+
+/**
+ *
+ * Columnar copy of `orders.csv` kept next to it. It remembers how far
+ * into the csv file it got so loading only parses the rows after that.
+ */
+const string SALES_CUBE_FILE_PATH = "../storage/orders.cube";
+
+enum SalesDimension { BY_DATE, BY_ORDER_STATE, BY_ITEM, BY_SIZE };
+enum SalesMeasure { QUANTITY, REVENUE };
+
+/**
+ *
+ * One line item per row. Item names are stored as ids into
+ * the cube's dictionary.
+ */
+struct SalesColumnBatch {
+    size_t size = 0;
+    /** Days since epoch */
+    array<int32_t, SALES_CUBE_BATCH_SIZE> dates;
+    array<uint8_t, SALES_CUBE_BATCH_SIZE> states;
+    array<uint16_t, SALES_CUBE_BATCH_SIZE> items;
+    array<uint8_t, SALES_CUBE_BATCH_SIZE> sizes;
+    array<uint32_t, SALES_CUBE_BATCH_SIZE> quantities;
+    array<double, SALES_CUBE_BATCH_SIZE> subtotals;
+
+    /** For skipping whole batches on date filters */
+    int32_t minDate = 0;
+    int32_t maxDate = 0;
+};
+
+using SalesSelection = array<uint64_t, SALES_CUBE_SELECTION_WORDS>;
+
+class SalesQuery {
+   private:
+    optional<long> fromDate;
+    optional<long> toDate;
+    optional<OrderState> orderState;
+    optional<OrderState> excludedState;
+    optional<string> itemName;
+    optional<MenuItemSizes> itemSize;
+    vector<SalesDimension> dimensions;
+    SalesMeasure salesMeasure;
+
+   public:
+    SalesQuery();
+
+    /**
+     *
+     * Both dates are inclusive. Only the date part is used.
+     */
+    SalesQuery& between(const tm&, const tm&);
+    SalesQuery& withState(const OrderState&);
+    /** Leaves out the orders in the state, i.e. cancelled ones */
+    SalesQuery& withoutState(const OrderState&);
+    SalesQuery& withItem(const string&);
+    SalesQuery& withSize(const MenuItemSizes&);
+    SalesQuery& groupBy(const SalesDimension&);
+    SalesQuery& measure(const SalesMeasure&);
+
+    friend class SalesCube;
+};
+
+struct SalesCubeRow {
+    /**
+     *
+     * Values of the group-by dimensions, in the order they were added
+     */
+    vector<string> keys;
+    size_t count;
+    double sum;
+    double average;
+};
+
+class SalesCube {
+   private:
+    vector<SalesColumnBatch> batches;
+    vector<string> itemNames;
+    unordered_map<string, uint16_t> itemIds;
+    /**
+     *
+     * How far into `orders.csv` the rows go
+     */
+    streamoff csvOffset;
+
+    uint16_t internItemName(const string&);
+    void selectBatch(const SalesColumnBatch&, const SalesQuery&,
+                     optional<uint16_t>, SalesSelection&) const noexcept;
+    string keyToString(const SalesDimension&, uint64_t) const;
+
+   public:
+    SalesCube();
+
+    void append(const Order&);
+    size_t getRowCount() const noexcept;
+
+    /**
+     *
+     * Reads `SALES_CUBE_FILE_PATH` if there is one, catches up with
+     * the rows added to the csv file since and saves the result.
+     */
+    void loadFromStorage();
+    void loadFromCsv(const string&);
+    bool loadBinary(const string&);
+    void saveBinary(const string&) const;
+
+    vector<SalesCubeRow> run(const SalesQuery&) const;
+};
+
+SalesCube& getSalesCube() noexcept;
+void initializeSalesCube();
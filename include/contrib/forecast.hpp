@@ -0,0 +1,128 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <contrib/storage.hpp>
+#include <contrib/utils.hpp>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+const size_t DEMAND_FORECAST_HOURS = 7 * 24;
+/**
+ *
+ * How far ahead the prep forecast shown to the staff looks
+ */
+const unsigned int DEMAND_PREP_WINDOW_HOURS = 3;
+
+/**
+ *
+ * Demand of a single item. The weekly quantity is fitted with a
+ * least squares line over the closed weeks (the trend) and spread
+ * over the hours of the week the same way past sales were (the
+ * seasonal part).
+ */
+class ItemDemandModel {
+   private:
+    array<double, DEMAND_FORECAST_HOURS> hourlyQuantities;
+    double totalQuantity;
+
+    // running sums of the least squares fit, x being the week
+    // and y the quantity sold that week
+    double weekCount;
+    double sumWeeks;
+    double sumQuantities;
+    double sumWeeksQuantities;
+    double sumWeeksSquared;
+
+    long currentWeek;
+    double currentWeekQuantity;
+
+   public:
+    ItemDemandModel();
+
+    void record(long, double) noexcept;
+    /**
+     *
+     * Adds the current week to the fit along with a zero for
+     * every week in between that had no sale of the item.
+     */
+    void closeWeeksUntil(long) noexcept;
+    /**
+     *
+     * Replaces the model with the quantities sold per hour of week
+     * and per week from the first to the last week given. The last
+     * week is left open.
+     */
+    void fit(const array<double, DEMAND_FORECAST_HOURS>&,
+             const map<long, double>&, long, long) noexcept;
+
+    double getWeeklyQuantity(long) const noexcept;
+    double forecast(long) const noexcept;
+};
+
+class DemandForecaster {
+   private:
+    struct ItemHistory {
+        array<double, DEMAND_FORECAST_HOURS> hourly = {};
+        map<long, double> weekly;
+    };
+
+    /** What a single chunk of the file sold, during training */
+    struct ChunkHistory {
+        unordered_map<string, ItemHistory> items;
+        long firstWeek = -1;
+        long lastWeek = -1;
+    };
+
+    unordered_map<string, ItemDemandModel> models;
+    long currentWeek;
+
+   public:
+    DemandForecaster();
+
+    /**
+     *
+     * Fits every item from scratch, reading the file one
+     * chunk per thread.
+     */
+    void train(const string&);
+    void recordOrder(const Order&);
+
+    /**
+     *
+     * Expected quantity of the item sold during the given hour
+     */
+    double forecast(const string&, const tm&) const noexcept;
+    /**
+     *
+     * Sum of the forecasts of the next `hours` hours, the current
+     * one included.
+     */
+    double forecast(const string&, const tm&, unsigned int) const noexcept;
+};
+
+DemandForecaster& getDemandForecaster() noexcept;
+/**
+ *
+ * Has to come before `initializeState()` since the prep
+ * forecast is made while the menu is set up, and made again
+ * after the forecaster took in each saved order.
+ */
+void initializeDemandForecaster();
@@ -0,0 +1,163 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <contrib/storage.hpp>
+#include <contrib/utils.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+/**
+ *
+ * How many of the latest samples of a bucket (i.e. the last 8
+ * Mondays between 10:00 and 11:00) are kept for its percentiles.
+ */
+const size_t SALES_BASELINE_WINDOW = 8;
+/**
+ *
+ * Weight of the newest sample. Samples of a weekday bucket only
+ * come once a week, so this leans towards recent weeks.
+ */
+const double SALES_BASELINE_ALPHA = 0.3;
+/**
+ *
+ * A bucket is not graded until it has seen this many samples.
+ */
+const size_t SALES_BASELINE_MIN_SAMPLES = 2;
+const double SALES_BASELINE_LOW_PERCENTILE = 0.1;
+const double SALES_BASELINE_HIGH_PERCENTILE = 0.9;
+
+enum SalesGrade { UNGRADED, UNDERPERFORMING, ON_TRACK, OVERPERFORMING };
+
+string salesGradeToString(const SalesGrade&) noexcept;
+
+struct SalesGradeResult {
+    SalesGrade grade;
+    double revenue;
+    /**
+     *
+     * Scaled to how much of the period has elapsed.
+     */
+    double expected;
+    double low;
+    double high;
+};
+
+class ExponentialMovingAverage {
+   private:
+    double alpha;
+    double value;
+    bool hasValue;
+
+   public:
+    ExponentialMovingAverage();
+    ExponentialMovingAverage(double);
+
+    void update(double) noexcept;
+    double getValue() const noexcept;
+};
+
+/**
+ *
+ * Keeps the latest `SALES_BASELINE_WINDOW` samples in a ring buffer.
+ * Percentiles are taken from a copy of at most that many samples, so
+ * both pushing and querying are constant time.
+ */
+class RollingPercentiles {
+   private:
+    array<double, SALES_BASELINE_WINDOW> samples;
+    size_t head;
+    size_t count;
+
+   public:
+    RollingPercentiles();
+
+    void push(double) noexcept;
+    double percentile(double) const noexcept;
+    size_t getCount() const noexcept;
+};
+
+class SalesBaseline {
+   private:
+    ExponentialMovingAverage average;
+    RollingPercentiles percentiles;
+
+   public:
+    SalesBaseline();
+
+    void update(double) noexcept;
+    double getExpected() const noexcept;
+    /**
+     *
+     * Grades `revenue` of a period where only `elapsedFraction`
+     * (0 to 1) of the expected sales should have come in yet.
+     */
+    SalesGradeResult grade(double, double) const noexcept;
+};
+
+/**
+ *
+ * Grades sales against the same weekday's history, per hour of the
+ * week, per day, and per menu item. Each recorded order only touches
+ * the buckets it falls into, so it can keep running inside the POS
+ * without re-reading `orders.csv`.
+ */
+class SalesGrader {
+   private:
+    struct ItemTracker {
+        array<SalesBaseline, 7> dailyBaselines;
+        long currentDay = -1;
+        double currentDayRevenue = 0;
+    };
+
+    array<SalesBaseline, 7 * 24> hourlyBaselines;
+    array<SalesBaseline, 7> dailyBaselines;
+    unordered_map<string, ItemTracker> itemTrackers;
+
+    /** Hours since epoch of the open hourly bucket */
+    long currentHour;
+    double currentHourRevenue;
+
+    /** Days since epoch of the open daily bucket */
+    long currentDay;
+    double currentDayRevenue;
+
+    void advanceToHour(long) noexcept;
+    void advanceToDay(long) noexcept;
+    void advanceItemToDay(ItemTracker&, long) noexcept;
+
+    double expectedFractionOfDay(const tm&) const noexcept;
+
+   public:
+    SalesGrader();
+
+    void recordOrder(const Order&);
+
+    SalesGradeResult gradeHour(const tm&) const noexcept;
+    SalesGradeResult gradeDay(const tm&) const noexcept;
+    SalesGradeResult gradeItem(const string&, const tm&) const noexcept;
+};
+
+SalesGrader& getSalesGrader() noexcept;
+/**
+ *
+ * Replays `orders.csv` once and keeps grading every order saved
+ * afterwards.
+ */
+void initializeSalesGrader();
@@ -0,0 +1,106 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <array>
+#include <cassert>
+#include <contrib/storage.hpp>
+#include <contrib/utils.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ *
+ * Progress of a Z-report that is still being generated. Removed
+ * once the report is done.
+ */
+const string Z_REPORT_CHECKPOINT_PATH = "../storage/zreport.checkpoint";
+/**
+ *
+ * How many orders are read between checkpoints
+ */
+const size_t Z_REPORT_CHECKPOINT_INTERVAL = 500;
+
+struct ZReportItemLine {
+    uint32_t quantity = 0;
+    double sales = 0;
+};
+
+/**
+ *
+ * End-of-day totals. Cancelled orders are counted but are not part
+ * of the sales, VAT or item mix.
+ */
+class ZReport {
+   private:
+    string date;
+    size_t orderCount;
+    array<size_t, 3> stateCounts;
+    double grossSales;
+    double VAT;
+    double cancelledSales;
+    uint32_t itemsSold;
+    /**
+     *
+     * Bounded by the size of the catalog, not by the number
+     * of orders.
+     */
+    map<string, ZReportItemLine> itemMix;
+    optional<string> firstOrderUid;
+    string firstOrderTime;
+    optional<string> lastOrderUid;
+    string lastOrderTime;
+
+   public:
+    ZReport(const tm&);
+
+    void record(const Order&);
+
+    string getDate() const noexcept;
+    size_t getOrderCount() const noexcept;
+    size_t getOrderCount(const OrderState&) const noexcept;
+    double getGrossSales() const noexcept;
+    double getVAT() const noexcept;
+    double getNetSales() const noexcept;
+    double getCancelledSales() const noexcept;
+    uint32_t getItemsSold() const noexcept;
+    const map<string, ZReportItemLine>& getItemMix() const noexcept;
+
+    /**
+     *
+     * The report as printable lines
+     */
+    vector<string> toLines() const;
+
+    void saveCheckpoint(const string&, streamoff) const;
+    /**
+     *
+     * Returns the byte offset in `orders.csv` to continue from, or
+     * nothing if the file isn't a checkpoint of this report's date.
+     */
+    optional<streamoff> loadCheckpoint(const string&);
+};
+
+/**
+ *
+ * Reads the orders of the given day in a single pass. If a checkpoint
+ * of the same day is found, the pass picks up where it left off.
+ */
+ZReport generateZReport(const tm&);
+ZReport generateZReport(const tm&, const string&, const string&);
@@ -12,8 +12,10 @@
 #endif
 
 #include <algorithm>
+#include <contrib/forecast.hpp>
 #include <contrib/menu.hpp>
 #include <contrib/storage.hpp>
+#include <unordered_map>
 #include <iostream>
 #include <memory>
 #include <optional>
@@ -44,6 +46,14 @@ class State {
 
     optional<Order> orderInfo;
 
+    /**
+     *
+     * Expected quantity of each item over the next
+     * `DEMAND_PREP_WINDOW_HOURS`, made when the menu is set up and
+     * again whenever an order is saved
+     */
+    unordered_map<string, double> prepForecasts;
+
    public:
     void appendMenuItemData(const MenuItemData&);
     void removeMenuItemDataWithName(const string&);
@@ -83,6 +93,9 @@ class State {
     const vector<MenuItem>& getMenuItemsInCart() const noexcept;
     void clearMenuItemsInCart() noexcept;
     const vector<MenuItemSizeData>& getMenuItemSizesData() const noexcept;
+
+    double getPrepForecast(const string&) const noexcept;
+    void setPrepForecast(const string&, const double&);
 };
 
 State& getState() noexcept;
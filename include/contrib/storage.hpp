@@ -17,8 +17,12 @@
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <optional>
+#include <limits>
 #include <string>
+#include <thread>
 #include <utils.hpp>
 #include <vector>
 
@@ -28,6 +32,9 @@ using namespace string_utils;
 
 const double TAX = 0.12;
 
+const string STORAGE_DIRECTORY = "../storage";
+const string ORDERS_FILE_PATH = "../storage/orders.csv";
+
 enum OrderState { PENDING, FINISHED, CANCELLED };
 
 class Order {
@@ -64,7 +71,103 @@ class Order {
     double getVAT() const noexcept;
 };
 
+/**
+ *
+ * Reads the orders in `orders.csv` one at a time by grouping
+ * consecutive rows that share an order uid, so only a single
+ * order is held in memory at any point.
+ */
+class OrderReader {
+   private:
+    ifstream file;
+    /**
+     *
+     * Byte offset of the next unread row
+     */
+    streamoff offset;
+    /**
+     *
+     * Byte offset of the first row after the headers
+     */
+    streamoff firstRowOffset;
+
+    /**
+     *
+     * First row of the next order. It gets read while looking for
+     * the end of the previous one.
+     */
+    vector<string> pendingRow;
+    streamoff pendingRowOffset;
+    /**
+     *
+     * Date part of `Date Created` that rows must start with
+     */
+    optional<string> dateFilter;
+
+    bool readRow(vector<string>&, streamoff&);
+
+   public:
+    OrderReader();
+    OrderReader(const string&);
+
+    bool isOpen() const noexcept;
+    optional<Order> next();
+
+    /**
+     *
+     * Byte offset of the order that `next()` will return.
+     * Can be passed to `seek()` to resume reading from there.
+     */
+    streamoff tell() const noexcept;
+    void seek(streamoff);
+    /**
+     *
+     * Moves to the first order that starts after the row containing
+     * the given byte offset. Used to split the file into chunks that
+     * can be read in parallel without cutting an order in half.
+     */
+    void seekToNextOrderFrom(streamoff);
+    /**
+     *
+     * Only returns orders created on the given day. Rows of other
+     * days are skipped without being parsed.
+     */
+    void filterByDate(const tm&);
+};
+
+using OrderSavedCallback = function<void(const Order&)>;
+/**
+ *
+ * Receives the index of the chunk the order was read from.
+ */
+using OrderChunkCallback = function<void(size_t, const Order&)>;
+
 string orderStateToString(const OrderState&) noexcept;
 OrderState orderStateFromString(const string&);
 optional<Order> getOrder(const string&);
 void saveOrder(const Order& order);
+/**
+ *
+ * Callbacks run after an order has been written to storage.
+ */
+void subscribeToSavedOrders(OrderSavedCallback);
+
+/**
+ *
+ * How many threads a pass over `orders.csv` should use.
+ * Small files are not worth spawning threads for.
+ */
+size_t getOrderChunkCount(const string&);
+/**
+ *
+ * Returns `chunkCount + 1` byte offsets where chunk `i` covers
+ * the orders starting in `[offsets[i], offsets[i + 1])`.
+ */
+vector<streamoff> splitOrdersIntoChunks(const string&, size_t);
+/**
+ *
+ * Reads every chunk on its own thread. The callback must only
+ * touch state that belongs to the chunk index it receives.
+ */
+void readOrderChunksInParallel(const string&, const vector<streamoff>&,
+                               OrderChunkCallback);
@@ -32,6 +32,7 @@ class MoneyPunct : public numpunct<char> {
 };
 
 string getCurrentDate();
+tm getCurrentDateTime();
 double calculateChange(const double&, const double&);
 double calculateTotalOfChosenMenuItems();
 
@@ -42,3 +43,38 @@ string formatDoublePrecision(const double&);
 string formatDoublePrecision(const double&, const int&);
 string parseDate(const tm&);
 tm parseDate(const string&);
+/**
+ *
+ * Same as `parseDate()` but includes the time of day.
+ * Parsing falls back to a date-only string (with the time
+ * set to midnight) for orders stored before timestamps were saved.
+ */
+string parseDateTime(const tm&);
+tm parseDateTime(const string&);
+/**
+ *
+ * Days since 1970-01-01 of the calendar date in `tm`.
+ * Does not touch the timezone database like `mktime()` does.
+ */
+long daysSinceEpoch(const tm&) noexcept;
+/**
+ *
+ * Inverse of `daysSinceEpoch()`. Only the date fields are set.
+ */
+tm dateFromDaysSinceEpoch(long) noexcept;
+/**
+ *
+ * 0 is Sunday, same as `tm::tm_wday`
+ */
+unsigned int weekdayOfEpochDay(long) noexcept;
+/**
+ *
+ * Weeks since epoch, each starting on a Sunday
+ */
+long weekOfEpochDay(long) noexcept;
+/**
+ *
+ * 0 is Sunday between 00:00 and 01:00, 167 is Saturday between
+ * 23:00 and 24:00.
+ */
+size_t hourOfWeek(long) noexcept;
@@ -0,0 +1,186 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+template <typename>
+class Delegate;
+
+/**
+ *
+ * A callable stored inline in three words, where `std::function`
+ * would keep it behind a pointer. It only takes callables that fit
+ * and are trivially copyable, like function pointers and lambdas
+ * that capture pointers or numbers. Copying one copies its bytes,
+ * and it never allocates.
+ */
+template <typename R, typename... Args>
+class Delegate<R(Args...)> {
+   private:
+    static constexpr size_t CAPACITY = 3 * sizeof(void *);
+
+    alignas(void *) unsigned char storage[CAPACITY];
+    R (*invoker)(const void *, Args...);
+
+   public:
+    Delegate() noexcept : storage{}, invoker(nullptr) {}
+
+    template <typename F,
+              typename = enable_if_t<!is_same_v<decay_t<F>, Delegate>>>
+    Delegate(F callable) noexcept : storage{} {
+        static_assert(sizeof(F) <= CAPACITY,
+                      "Delegate received a callable that doesn't fit");
+        static_assert(alignof(F) <= alignof(void *),
+                      "Delegate received an overaligned callable");
+        static_assert(is_trivially_copyable_v<F>,
+                      "Delegate only takes trivially copyable callables");
+
+        new (storage) F(callable);
+        invoker = [](const void *stored, Args... args) -> R {
+            return (*static_cast<const F *>(stored))(forward<Args>(args)...);
+        };
+    }
+
+   public:
+    R operator()(Args... args) const {
+        assert(invoker != nullptr || !"Called an empty Delegate");
+
+        return invoker(storage, forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return invoker != nullptr; }
+};
+
+/**
+ *
+ * Handle to a callback connected to a `Signal`. A copy of the
+ * signal keeps its slots, so the handle stays good for the copy.
+ */
+struct Connection {
+    uint32_t slot;
+    uint32_t generation;
+};
+
+const Connection NO_CONNECTION = {numeric_limits<uint32_t>::max(), 0};
+
+/**
+ *
+ * Callbacks to call with `Args...`. Disconnecting is O(1): the
+ * slot is marked free and reused by the next `connect()`, and
+ * its generation is bumped so older handles to it stop working.
+ */
+template <typename... Args>
+class Signal {
+   public:
+    using Callback = Delegate<void(Args...)>;
+
+   private:
+    struct Slot {
+        Callback callback;
+        uint32_t generation;
+        bool isConnected;
+    };
+
+    vector<Slot> slots;
+    vector<uint32_t> freeSlots;
+
+   public:
+    Connection connect(Callback callback) {
+        uint32_t slot;
+
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(slots.size());
+            slots.push_back({Callback(), 0, false});
+            // so that `disconnect()` never has to allocate
+            freeSlots.reserve(slots.size());
+        }
+
+        slots[slot].callback = callback;
+        slots[slot].isConnected = true;
+
+        return {slot, slots[slot].generation};
+    }
+
+    /** Does nothing if the callback was disconnected already */
+    void disconnect(Connection connection) noexcept {
+        if (!isConnected(connection)) {
+            return;
+        }
+
+        Slot &slot = slots[connection.slot];
+
+        slot.callback = Callback();
+        slot.isConnected = false;
+        ++slot.generation;
+        freeSlots.push_back(connection.slot);
+    }
+
+    void disconnectAll() noexcept {
+        for (uint32_t i = 0; i < slots.size(); ++i) {
+            disconnect({i, slots[i].generation});
+        }
+    }
+
+    /**
+     *
+     * Disconnects everything and keeps the slots, so the next
+     * callbacks are connected in order without allocating
+     */
+    void clear() noexcept {
+        freeSlots.clear();
+
+        for (size_t i = slots.size(); i-- > 0;) {
+            if (slots[i].isConnected) {
+                slots[i].callback = Callback();
+                slots[i].isConnected = false;
+                ++slots[i].generation;
+            }
+
+            freeSlots.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    bool isConnected(Connection connection) const noexcept {
+        return connection.slot < slots.size() &&
+               slots[connection.slot].isConnected &&
+               slots[connection.slot].generation == connection.generation;
+    }
+
+    /** Number of connected callbacks */
+    size_t size() const noexcept { return slots.size() - freeSlots.size(); }
+
+    void emit(Args... args) const {
+        // a callback may connect or disconnect others, so the slots
+        // are indexed instead of iterated and each one is copied
+        // before it is called
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].isConnected) {
+                Callback callback = slots[i].callback;
+
+                callback(args...);
+            }
+        }
+    }
+};
@@ -28,6 +28,8 @@
 #define KEY_r 114
 #define KEY_O 79
 #define KEY_o 111
+#define KEY_Z 90
+#define KEY_z 122
 #define KEY_PLUS 43
 #define KEY_HYPHEN_MINUS 45
 #define KEY_ESC 27
@@ -1,10 +1,19 @@
 #pragma once
 
 #include <algorithm>
+#include <ast/arena.hpp>
+#include <ast/bindings.hpp>
 #include <ast/node.hpp>
+#include <ast/reconciler.hpp>
+#include <ast/snapshot.hpp>
+#include <ast/view.hpp>
 #include <cassert>
 #include <constants/metadata.hpp>
+#include <contrib/affinity.hpp>
+#include <contrib/cube.hpp>
+#include <contrib/grading.hpp>
 #include <contrib/menu.hpp>
+#include <contrib/report.hpp>
 #include <contrib/state.hpp>
 #include <contrib/storage.hpp>
 #include <contrib/utils.hpp>
@@ -32,6 +41,7 @@ void onAddMinusBtnClicked(unsigned int);
 
 void onAdminBtnClicked(unsigned int);
 void onCheckoutBtnClicked(unsigned int);
+void onZReportBtnClicked(unsigned int);
 
 enum RendererState {
     MENU,
@@ -44,19 +54,103 @@ enum RendererState {
     ADMIN_MENU
 };
 
+const size_t RENDERER_STATE_COUNT = RendererState::ADMIN_MENU + 1;
+
+enum ChromeSection { HEADER_CHROME, FOOTER_CHROME };
+
+/**
+ *
+ * Size of the blocks the nodes of a cached header or footer are
+ * carved out of. They are a handful of nodes each.
+ */
+const size_t CHROME_NODE_ARENA_BLOCK_SIZE = 1024;
+
 class Renderer {
    private:
-    shared_ptr<ContainerNode> rootNode;
-    shared_ptr<ContainerNode> header;
-    shared_ptr<ContainerNode> body;
-    shared_ptr<ContainerNode> footer;
+    /**
+     *
+     * Owns every node of the view on screen
+     */
+    NodeArena retainedNodeArena;
+    /**
+     *
+     * Where the `create*` methods describe the view for the
+     * current state. Emptied once it is reconciled with the
+     * retained view, unless it replaces it.
+     */
+    NodeArena nodeArena;
+    /**
+     *
+     * Keeps the previous view alive while a key is still being
+     * dispatched to it, after one of its handlers created a new one.
+     */
+    NodeArena dispatchedNodeArena;
+    bool isDispatchingKey;
+    bool keepsDispatchedView;
+
+    /**
+     *
+     * Interactable nodes of the retained view by the keys they
+     * take. The body is focused, so the header and footer only
+     * get the keys it doesn't take.
+     */
+    KeyBindingTable keyBindings;
+
+    /**
+     *
+     * Header or footer that only changes with the screen's width,
+     * laid out and rendered once and written as is after that
+     */
+    struct CachedChrome {
+        /** Keeps the nodes alive, so their buttons still take keys */
+        NodeArena nodeArena{CHROME_NODE_ARENA_BLOCK_SIZE};
+        optional<NodeSnapshot> snapshot;
+        unsigned int screenWidth = 0;
+    };
+
+    /** Indexed by `RendererState`, then by `ChromeSection` */
+    unique_ptr<CachedChrome> chromeCache[RENDERER_STATE_COUNT][2];
+
+    /** Root of the retained view */
+    ContainerNode* rootNode;
+    /** Screen width the retained view was made for */
+    unsigned int viewWidth;
+    /** Sections of the view being described */
+    ContainerNode* header;
+    ContainerNode* body;
+    ContainerNode* footer;
+
+    /**
+     *
+     * Menu items in the order the menu view lists them, kept
+     * here so the list's subscriber only has to capture `this`
+     */
+    vector<size_t> rankedMenuItemIds;
 
    public:
     ostringstream buf;
     RendererState viewState;
+    /**
+     *
+     * Last Z-report generated from the admin menu, dropped once
+     * the day it is for is over
+     */
+    optional<ZReport> zReport;
     Renderer();
 
    private:
+    void createTitle();
+    /** Appends the buttons to the header */
+    void createNav(const ButtonBarSpec&);
+    /** Appends the buttons to the footer, between two lines */
+    void createToolTips(const ButtonBarSpec&);
+    /**
+     *
+     * Appends the header or footer `create` makes for the current
+     * state, from the cache. It is only made again once the screen
+     * has another width.
+     */
+    void createCachedChrome(ChromeSection, void (Renderer::*)(bool));
     // header
     void createMenuHeader(bool);
     void createMenuItemHeader(bool);
@@ -92,13 +186,31 @@ class Renderer {
      * reset it.
      */
     void renderBuffer() noexcept;
+    /**
+     *
+     * Describes the view for the current state and reconciles
+     * it with the one on screen. The retained nodes are patched
+     * in place when only their props changed, otherwise the
+     * described view replaces them.
+     */
     void createView();
+    /**
+     *
+     * Lays out and paints only what changed since the
+     * last frame.
+     */
+    void updateView();
+
+   private:
+    /**
+     *
+     * Binds the keys of the retained view, once it is created
+     * or patched
+     */
+    void bindKeys();
 
    public:
     void onKeyPressed(unsigned int);
-
-   private:
-    void onKeyPressed(unsigned int, Node::NodePtr);
 };
 
 Renderer& getRenderer() noexcept;
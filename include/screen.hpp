@@ -16,20 +16,20 @@
 #include <cassert>
 #include <csignal>
 #include <cstdint>
-#include <functional>
+#include <delegate.hpp>
 #include <iostream>
 
 using namespace std;
 
 class Screen {
    public:
-    using SubscriberCallback = function<void()>;
+    using SubscriberCallback = Delegate<void()>;
 
    private:
     unsigned int width;
     unsigned int height;
 
-    vector<SubscriberCallback> subscribers;
+    Signal<> subscribers;
 
    public:
     Screen();
@@ -40,8 +40,8 @@ class Screen {
 
    public:
     void updateScreenDimensions();
-    void subscribe(SubscriberCallback);
-    void unsubscribe(SubscriberCallback);
+    Connection subscribe(SubscriberCallback);
+    void unsubscribe(Connection) noexcept;
 
    public:
     unsigned int getWidth() const noexcept;
@@ -37,6 +37,12 @@ namespace miscellaneous {
 namespace string_utils {
 string kebabToPascal(const string &) noexcept;
 string kebabToPascal(const string &, const bool) noexcept;
+/**
+ *
+ * Like `kebabToPascal()`, but appends to the given string so its
+ * capacity can be reused
+ */
+void appendKebabToPascal(string &, const string &, const bool) noexcept;
 string genRandomID(size_t);
 /**
  *
@@ -44,6 +50,27 @@ string genRandomID(size_t);
  * we need this
  */
 size_t numOfUtf8Chars(const string &);
+/**
+ *
+ * Decodes the code point starting at byte `idx` of the
+ * string into `codePoint`. Returns how many bytes it takes.
+ * A malformed sequence decodes its first byte as U+FFFD.
+ */
+size_t decodeUtf8(const string &, size_t, char32_t &) noexcept;
+/**
+ *
+ * Columns a code point takes in a terminal. 2 for East Asian
+ * wide and fullwidth characters, 0 for combining marks and
+ * other zero-width ones, 1 for everything else.
+ */
+unsigned int codePointWidth(char32_t) noexcept;
+/**
+ *
+ * Columns the string takes in a terminal, unlike `size()` or
+ * `numOfUtf8Chars()`. Runs of ASCII are counted a block of
+ * bytes at a time.
+ */
+size_t displayWidth(const string &);
 }
 
 namespace terminal {
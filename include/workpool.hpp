@@ -0,0 +1,99 @@
+#pragma once
+
+#if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
+#include <unistd.h>
+
+#elif defined(WINDOWS_PLATFORM)
+#include <windows.h>
+
+#else
+#error "Unsupported Platform!"
+
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <delegate.hpp>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ *
+ * Tasks forked together, to be joined together
+ */
+class TaskGroup {
+   private:
+    atomic<size_t> pendingCount;
+
+    friend class WorkStealingPool;
+
+   public:
+    TaskGroup() noexcept;
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+};
+
+/**
+ *
+ * Threads that each run the tasks forked on them newest first,
+ * and take the oldest task of another thread once they run out.
+ * Threads outside of the pool fork onto a queue of their own.
+ * A thread joining a group runs tasks until the group is done,
+ * so tasks can fork and join tasks of their own.
+ */
+class WorkStealingPool {
+   private:
+    struct Task {
+        Delegate<void()> run;
+        TaskGroup *group;
+    };
+
+    struct TaskQueue {
+        mutex lock;
+        deque<Task> tasks;
+    };
+
+    /** Queue 0 is for the threads outside of the pool */
+    vector<unique_ptr<TaskQueue>> queues;
+    vector<thread> workers;
+    atomic<size_t> queuedCount;
+    mutex sleepLock;
+    condition_variable wakeUp;
+    bool isStopping;
+
+   private:
+    /** Queue the calling thread forks onto */
+    size_t ownQueue() const noexcept;
+    bool takeTask(size_t, Task &);
+    void runTask(Task &) noexcept;
+    void work(size_t);
+
+   public:
+    /**
+     *
+     * Starts `threadCount - 1` threads, as the thread that joins
+     * runs tasks too
+     */
+    WorkStealingPool(size_t);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+   public:
+    size_t getThreadCount() const noexcept;
+
+    void fork(TaskGroup &, Delegate<void()>);
+    /**
+     *
+     * Returns once every task forked in the group has run
+     */
+    void join(TaskGroup &);
+};
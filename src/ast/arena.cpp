@@ -0,0 +1,74 @@
+#include <ast/arena.hpp>
+
+NodeArena::NodeArena()
+    : blockSize(NODE_ARENA_BLOCK_SIZE),
+      currentBlock(0),
+      offset(0),
+      lastObject(nullptr),
+      objectCount(0) {}
+
+NodeArena::NodeArena(size_t blockSize)
+    : blockSize(blockSize),
+      currentBlock(0),
+      offset(0),
+      lastObject(nullptr),
+      objectCount(0) {
+    assert(blockSize > 0 || !"NodeArena block size must be > 0");
+}
+
+NodeArena::~NodeArena() { reset(); }
+
+void* NodeArena::allocate(size_t size, size_t align) {
+    while (currentBlock < blocks.size()) {
+        Block& block = blocks.at(currentBlock);
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        size_t aligned = (base + offset + align - 1) / align * align - base;
+
+        if (aligned + size <= block.size) {
+            offset = aligned + size;
+
+            return block.data.get() + aligned;
+        }
+
+        ++currentBlock;
+        offset = 0;
+    }
+
+    // new blocks come out of `new[]`, which is aligned for any
+    // fundamental type
+    size_t newBlockSize = size > blockSize ? size : blockSize;
+
+    blocks.push_back(
+        {make_unique<unsigned char[]>(newBlockSize), newBlockSize});
+
+    currentBlock = blocks.size() - 1;
+    offset = size;
+
+    return blocks.back().data.get();
+}
+
+void NodeArena::reset() noexcept {
+    while (lastObject != nullptr) {
+        ObjectHeader* header = lastObject;
+
+        lastObject = header->prev;
+        header->destroy(header->object);
+    }
+
+    currentBlock = 0;
+    offset = 0;
+    objectCount = 0;
+}
+
+void NodeArena::swap(NodeArena& other) noexcept {
+    blocks.swap(other.blocks);
+    std::swap(blockSize, other.blockSize);
+    std::swap(currentBlock, other.currentBlock);
+    std::swap(offset, other.offset);
+    std::swap(lastObject, other.lastObject);
+    std::swap(objectCount, other.objectCount);
+}
+
+size_t NodeArena::getObjectCount() const noexcept { return objectCount; }
+
+size_t NodeArena::getBlockCount() const noexcept { return blocks.size(); }
@@ -0,0 +1,90 @@
+#include <ast/bindings.hpp>
+#include <ast/node.hpp>
+
+KeyBindingTable::KeyBindingTable()
+    : scopeParents{ROOT_FOCUS_SCOPE}, focusedScope(ROOT_FOCUS_SCOPE) {}
+
+void KeyBindingTable::clear() noexcept {
+    for (vector<KeyBinding>& keyBindings : bindings) {
+        keyBindings.clear();
+    }
+
+    scopeParents.resize(1);
+    focusedScope = ROOT_FOCUS_SCOPE;
+}
+
+FocusScopeId KeyBindingTable::openScope(FocusScopeId parent) {
+    assert(parent < scopeParents.size() ||
+           !"KeyBindingTable::openScope() received an unknown scope");
+
+    scopeParents.push_back(parent);
+
+    return static_cast<FocusScopeId>(scopeParents.size() - 1);
+}
+
+void KeyBindingTable::focus(FocusScopeId scope) noexcept {
+    assert(scope < scopeParents.size() ||
+           !"KeyBindingTable::focus() received an unknown scope");
+
+    focusedScope = scope;
+}
+
+FocusScopeId KeyBindingTable::getFocusedScope() const noexcept {
+    return focusedScope;
+}
+
+void KeyBindingTable::bind(unsigned int keyCode, InteractableNode* node,
+                           FocusScopeId scope) {
+    assert(scope < scopeParents.size() ||
+           !"KeyBindingTable::bind() received an unknown scope");
+
+    if (keyCode >= bindings.size()) {
+        bindings.resize(keyCode + 1);
+    }
+
+    bindings[keyCode].push_back({node, scope});
+}
+
+void KeyBindingTable::bindTree(const Node* node, FocusScopeId scope) {
+    for (Node::NodePtr c = node->getFirstChild(); c != nullptr;
+         c = c->getNextSibling()) {
+        if (c->nodeType() == NodeTypes::INTERACTABLE) {
+            static_cast<InteractableNode*>(c)->bindKeys(*this, scope);
+        }
+
+        bindTree(c, scope);
+    }
+}
+
+bool KeyBindingTable::dispatch(unsigned int keyCode) {
+    if (keyCode >= bindings.size() || bindings[keyCode].empty()) {
+        return false;
+    }
+
+    // a handler may create a new view and bind it in this table,
+    // so what the key goes to is taken out before any is called
+    dispatchedTargets.assign(bindings[keyCode].begin(),
+                             bindings[keyCode].end());
+
+    for (FocusScopeId scope = focusedScope;;) {
+        bool isHandled = false;
+
+        for (const KeyBinding& target : dispatchedTargets) {
+            if (target.scope == scope) {
+                isHandled = target.node->onKeyPressed(keyCode) || isHandled;
+            }
+        }
+
+        if (isHandled) {
+            return true;
+        }
+
+        if (scope == ROOT_FOCUS_SCOPE) {
+            return false;
+        }
+
+        // the scopes were dropped with the view a handler replaced
+        scope = scope < scopeParents.size() ? scopeParents[scope]
+                                            : ROOT_FOCUS_SCOPE;
+    }
+}
@@ -0,0 +1,1046 @@
+#include <ast/layout.hpp>
+#include <ast/spatial.hpp>
+#include <functional>
+#include <utils.hpp>
+#include <workpool.hpp>
+
+static unique_ptr<LayoutStore> layoutStore;
+
+/**
+ *
+ * Node whose children the thread is measuring a run of, so
+ * flagging their ancestors stops short of the ancestors other
+ * threads share. The run's parent is flagged once it is joined.
+ */
+static thread_local NodeHandle paintBoundary = NO_NODE;
+
+LayoutStore& getLayoutStore() noexcept { return *layoutStore; }
+
+void initializeLayoutStore() {
+    assert(!layoutStore || !"LayoutStore must only be initialized once");
+
+    layoutStore = make_unique<LayoutStore>();
+}
+
+/**
+ *
+ * Lines needed for `textSize` characters wrapped at `w` columns,
+ * never less than `minHeight`.
+ */
+static unsigned int wrappedHeight(unsigned int textSize, unsigned int w,
+                                  unsigned int minHeight) noexcept {
+    if (w == 0 || textSize <= w) {
+        return minHeight;
+    }
+
+    return max(minHeight, (textSize + w - 1) / w);
+}
+
+TextLines::TextLines(const string* text)
+    : text(text), isWrapped(false), wrappedWidth(0), isHashed(false),
+      textHash(0) {}
+
+const vector<TextLine>& TextLines::wrap(unsigned int w) {
+    if (isWrapped && wrappedWidth == w) {
+        return lines;
+    }
+
+    const string& str = *text;
+    uint32_t lineBegin = 0;
+    unsigned int lineWidth = 0;
+    // last space on the line, and how wide the line was before it
+    uint32_t lastSpace = 0;
+    unsigned int widthBeforeSpace = 0;
+    bool hasSpace = false;
+    // whether the line is only spaces so far, and was before the
+    // last space
+    bool isIndent = true;
+    bool isIndentBeforeSpace = true;
+
+    lines.clear();
+
+    for (uint32_t i = 0; i < str.size();) {
+        char32_t codePoint;
+        uint32_t len =
+            static_cast<uint32_t>(string_utils::decodeUtf8(str, i, codePoint));
+        unsigned int charWidth = string_utils::codePointWidth(codePoint);
+
+        if (lineWidth + charWidth <= w || i == lineBegin) {
+            if (codePoint == ' ') {
+                lastSpace = i;
+                widthBeforeSpace = lineWidth;
+                hasSpace = true;
+                isIndentBeforeSpace = isIndent;
+            } else {
+                isIndent = false;
+            }
+
+            lineWidth += charWidth;
+            i += len;
+        } else if (codePoint == ' ') {
+            // the spaces the line overflows at are dropped, and so
+            // is an indent wider than the line
+            if (!isIndent) {
+                lines.push_back({lineBegin, i});
+            }
+
+            while (i < str.size() && str[i] == ' ') {
+                ++i;
+            }
+
+            lineBegin = i;
+            lineWidth = 0;
+            hasSpace = false;
+            isIndent = true;
+        } else if (hasSpace) {
+            // the word is moved to the next line, without the space.
+            // An indent with no word before it is dropped instead of
+            // making a line of spaces.
+            if (!isIndentBeforeSpace) {
+                lines.push_back({lineBegin, lastSpace});
+            }
+
+            lineBegin = lastSpace + 1;
+            lineWidth -= widthBeforeSpace + 1;
+            hasSpace = false;
+            isIndent = lineBegin == i;
+        } else {
+            // a word longer than the line is cut
+            lines.push_back({lineBegin, i});
+            lineBegin = i;
+            lineWidth = 0;
+            isIndent = true;
+        }
+    }
+
+    if (lineBegin < str.size() || lines.empty()) {
+        lines.push_back({lineBegin, static_cast<uint32_t>(str.size())});
+    }
+
+    isWrapped = true;
+    wrappedWidth = w;
+
+    return lines;
+}
+
+void TextLines::invalidate() noexcept {
+    isWrapped = false;
+    isHashed = false;
+}
+
+size_t TextLines::getTextHash() noexcept {
+    if (!isHashed) {
+        textHash = hash<string>()(*text);
+        isHashed = true;
+    }
+
+    return textHash;
+}
+
+/**
+ *
+ * Folds `value` into `hash`, FNV-1a style, a word at a time
+ */
+static uint64_t mixHash(uint64_t hash, uint64_t value) noexcept {
+    return (hash ^ value) * 0x100000001b3ULL;
+}
+
+double MeasureCacheStats::hitRate() const noexcept {
+    size_t lookups = hits + misses;
+
+    return lookups == 0 ? 0 : static_cast<double>(hits) / lookups;
+}
+
+LayoutStore::LayoutStore()
+    : measureCacheStats{0, 0},
+      isMeasureCacheEnabled(true),
+      isMeasuringInParallel(false),
+      measureThreadCount(max(thread::hardware_concurrency(), 1u)),
+      parallelMeasureMinNodes(PARALLEL_MEASURE_MIN_NODES),
+      arrangedIndex(nullptr) {}
+
+LayoutStore::~LayoutStore() {}
+
+NodeHandle LayoutStore::create(Node* node, LayoutKind layoutKind) {
+    NodeHandle handle;
+
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        assert(nodes.size() < NO_NODE || !"LayoutStore ran out of handles");
+
+        handle = static_cast<NodeHandle>(nodes.size());
+
+        nodes.push_back(nullptr);
+        kind.push_back(FLOW_LAYOUT);
+        flags.push_back(0);
+        parent.push_back(NO_NODE);
+        firstChild.push_back(NO_NODE);
+        lastChild.push_back(NO_NODE);
+        prevSibling.push_back(NO_NODE);
+        nextSibling.push_back(NO_NODE);
+        childCount.push_back(0);
+        subtreeSize.push_back(1);
+        posX.push_back(0);
+        posY.push_back(0);
+        offsetX.push_back(0);
+        offsetY.push_back(0);
+        width.push_back(0);
+        height.push_back(0);
+        preferredWidth.push_back(0);
+        preferredHeight.push_back(0);
+        measuredInWidth.push_back(0);
+        colGap.push_back(0);
+        rowGap.push_back(0);
+        childWidth.push_back(0);
+        textSize.push_back(0);
+        textLines.push_back(nullptr);
+        flexGrow.push_back(0);
+        flexShrink.push_back(1);
+        flexBasis.push_back(0);
+        contentHash.push_back(0);
+        paintedX.push_back(0);
+        paintedY.push_back(0);
+        paintedWidth.push_back(0);
+        paintedHeight.push_back(0);
+        indexStamp.push_back(0);
+        indexedBand.push_back(0);
+        indexedBandCount.push_back(0);
+    }
+
+    nodes[handle] = node;
+    kind[handle] = layoutKind;
+    flags[handle] = LAYOUT_DIRTY | ARRANGE_DIRTY | PAINT_DIRTY;
+    parent[handle] = NO_NODE;
+    firstChild[handle] = NO_NODE;
+    lastChild[handle] = NO_NODE;
+    prevSibling[handle] = NO_NODE;
+    nextSibling[handle] = NO_NODE;
+    childCount[handle] = 0;
+    subtreeSize[handle] = 1;
+    posX[handle] = 0;
+    posY[handle] = 0;
+    offsetX[handle] = 0;
+    offsetY[handle] = 0;
+    width[handle] = 0;
+    height[handle] = 0;
+    preferredWidth[handle] = 0;
+    preferredHeight[handle] = 0;
+    measuredInWidth[handle] = 0;
+    colGap[handle] = 0;
+    rowGap[handle] = 0;
+    childWidth[handle] = 0;
+    textSize[handle] = 0;
+    textLines[handle] = nullptr;
+    flexGrow[handle] = 0;
+    flexShrink[handle] = 1;
+    flexBasis[handle] = 0;
+    indexStamp[handle] = 0;
+
+    return handle;
+}
+
+void LayoutStore::release(NodeHandle handle) noexcept {
+    // what is left of the tree goes with it
+    if ((flags[handle] & SPATIALLY_INDEXED) && parent[handle] == NO_NODE) {
+        spatialIndexes.erase(handle);
+    }
+
+    nodes[handle] = nullptr;
+    indexStamp[handle] = 0;
+    freeHandles.push_back(handle);
+}
+
+size_t LayoutStore::size() const noexcept {
+    return nodes.size() - freeHandles.size();
+}
+
+void LayoutStore::appendChild(NodeHandle node, NodeHandle child) noexcept {
+    parent[child] = node;
+    prevSibling[child] = lastChild[node];
+    nextSibling[child] = NO_NODE;
+
+    if (lastChild[node] != NO_NODE) {
+        nextSibling[lastChild[node]] = child;
+    } else {
+        firstChild[node] = child;
+    }
+
+    lastChild[node] = child;
+    ++childCount[node];
+
+    markLayoutDirty(node);
+}
+
+void LayoutStore::removeChild(NodeHandle node, NodeHandle child) noexcept {
+    if (flags[child] & SPATIALLY_INDEXED) {
+        unfileSubtree(child);
+    }
+
+    if (prevSibling[child] != NO_NODE) {
+        nextSibling[prevSibling[child]] = nextSibling[child];
+    } else {
+        firstChild[node] = nextSibling[child];
+    }
+
+    if (nextSibling[child] != NO_NODE) {
+        prevSibling[nextSibling[child]] = prevSibling[child];
+    } else {
+        lastChild[node] = prevSibling[child];
+    }
+
+    parent[child] = NO_NODE;
+    prevSibling[child] = NO_NODE;
+    nextSibling[child] = NO_NODE;
+    --childCount[node];
+
+    markLayoutDirty(node);
+}
+
+void LayoutStore::removeAllChildren(NodeHandle node) noexcept {
+    NodeHandle child = firstChild[node];
+
+    while (child != NO_NODE) {
+        NodeHandle next = nextSibling[child];
+
+        if (flags[child] & SPATIALLY_INDEXED) {
+            unfileSubtree(child);
+        }
+
+        parent[child] = NO_NODE;
+        prevSibling[child] = NO_NODE;
+        nextSibling[child] = NO_NODE;
+        child = next;
+    }
+
+    firstChild[node] = NO_NODE;
+    lastChild[node] = NO_NODE;
+    childCount[node] = 0;
+
+    markLayoutDirty(node);
+}
+
+NodeHandle LayoutStore::getChildAt(NodeHandle node, size_t idx) const
+    noexcept {
+    NodeHandle child = firstChild[node];
+
+    for (; idx > 0 && child != NO_NODE; --idx) {
+        child = nextSibling[child];
+    }
+
+    return child;
+}
+
+void LayoutStore::measureFlow(NodeHandle node,
+                              unsigned int availableWidth) noexcept {
+    unsigned int currX = 0;
+    unsigned int currY = 0;
+    unsigned int lineHeight = 0;
+    unsigned int contentWidth = 0;
+
+    measureChildrenInParallel(node, availableWidth);
+
+    for (NodeHandle child = firstChild[node]; child != NO_NODE;
+         child = nextSibling[child]) {
+        measure(child, availableWidth);
+
+        bool isBlock = !(flags[child] & INLINE_STYLE);
+
+        if (currX > 0 && (isBlock || currX + width[child] > availableWidth)) {
+            currX = 0;
+            currY += lineHeight;
+            lineHeight = 0;
+        }
+
+        offsetX[child] = currX;
+        offsetY[child] = currY;
+
+        contentWidth = max(contentWidth, currX + width[child]);
+
+        if (isBlock) {
+            currY += height[child];
+        } else {
+            currX += width[child];
+            lineHeight = max(lineHeight, height[child]);
+        }
+    }
+
+    width[node] = max(preferredWidth[node], contentWidth);
+    height[node] = max(preferredHeight[node], currY + lineHeight);
+}
+
+void LayoutStore::measureGrid(NodeHandle node,
+                              unsigned int availableWidth) noexcept {
+    unsigned int gridWidth = min(preferredWidth[node], availableWidth);
+    bool flexible = flags[node] & FLEXIBLE_GRID;
+    unsigned int currX = 0;
+    unsigned int currY = 0;
+    unsigned int rowHeight = 0;
+
+    // a flexible cell is measured in what the cells before it left
+    if (!flexible) {
+        measureChildrenInParallel(
+            node, childWidth[node] == 0 ? gridWidth : childWidth[node]);
+    }
+
+    for (NodeHandle child = firstChild[node]; child != NO_NODE;
+         child = nextSibling[child]) {
+        unsigned int cellWidth;
+
+        if (flexible) {
+            if (currX >= gridWidth) {
+                currX = 0;
+                currY += rowHeight + rowGap[node];
+                rowHeight = 0;
+            }
+
+            // have the child take the remaining width if it has no
+            // defined width or overflows
+            measure(child, gridWidth - currX);
+
+            cellWidth = width[child] == 0 ? gridWidth - currX : width[child];
+        } else {
+            measure(child,
+                    childWidth[node] == 0 ? gridWidth : childWidth[node]);
+
+            if (childWidth[node] != 0) {
+                cellWidth = childWidth[node];
+            } else if (width[child] == 0) {
+                cellWidth = gridWidth;
+            } else {
+                cellWidth = min(width[child], gridWidth);
+            }
+
+            // if overflow
+            if (currX > 0 && currX + cellWidth > gridWidth) {
+                currX = 0;
+                currY += rowHeight + rowGap[node];
+                rowHeight = 0;
+            }
+        }
+
+        offsetX[child] = currX;
+        offsetY[child] = currY;
+
+        currX += cellWidth + colGap[node];
+        rowHeight = max(rowHeight, height[child]);
+    }
+
+    width[node] = gridWidth;
+    height[node] = currY + rowHeight;
+}
+
+void LayoutStore::measureText(NodeHandle node,
+                              unsigned int availableWidth) noexcept {
+    unsigned int w =
+        preferredWidth[node] == 0 ? textSize[node] : preferredWidth[node];
+
+    width[node] = min(w, availableWidth);
+
+    if (textLines[node] != nullptr && textSize[node] > width[node]) {
+        const vector<TextLine>& lines = textLines[node]->wrap(width[node]);
+        unsigned int lineCount = static_cast<unsigned int>(lines.size());
+
+        height[node] = max(preferredHeight[node], lineCount);
+    } else {
+        height[node] =
+            wrappedHeight(textSize[node], width[node], preferredHeight[node]);
+    }
+}
+
+void LayoutStore::measureList(NodeHandle node,
+                              unsigned int availableWidth) noexcept {
+    unsigned int w =
+        preferredWidth[node] == 0 ? textSize[node] : preferredWidth[node];
+
+    width[node] = min(w, availableWidth);
+    height[node] = preferredHeight[node];
+}
+
+unsigned int LayoutStore::flexBaseSize(NodeHandle child,
+                                       unsigned int lineWidth) noexcept {
+    if (flexBasis[child] != 0) {
+        return flexBasis[child];
+    }
+
+    measure(child, lineWidth);
+
+    return width[child];
+}
+
+void LayoutStore::measureFlex(NodeHandle node,
+                              unsigned int availableWidth) noexcept {
+    unsigned int lineWidth = min(preferredWidth[node], availableWidth);
+    bool wraps = flags[node] & FLEX_WRAP;
+    unsigned int currY = 0;
+    NodeHandle lineStart = firstChild[node];
+
+    while (lineStart != NO_NODE) {
+        // find where the row ends and how much it can grow or shrink
+        unsigned int used = 0;
+        uint64_t totalGrow = 0;
+        uint64_t totalShrink = 0;
+        NodeHandle lineEnd = lineStart;
+
+        for (; lineEnd != NO_NODE; lineEnd = nextSibling[lineEnd]) {
+            unsigned int size = flexBaseSize(lineEnd, lineWidth);
+            unsigned int gap = lineEnd == lineStart ? 0 : colGap[node];
+
+            if (wraps && lineEnd != lineStart &&
+                used + gap + size > lineWidth) {
+                break;
+            }
+
+            used += gap + size;
+            totalGrow += flexGrow[lineEnd];
+            totalShrink += static_cast<uint64_t>(flexShrink[lineEnd]) * size;
+        }
+
+        // hand the free space, or the overflow, out in proportion.
+        // Shares are taken off running totals so they add up exactly.
+        bool grows = used < lineWidth && totalGrow > 0;
+        bool shrinks = used > lineWidth && totalShrink > 0;
+        uint64_t space = grows ? lineWidth - used : used - lineWidth;
+        uint64_t total = grows ? totalGrow : totalShrink;
+        uint64_t weightSoFar = 0;
+        uint64_t handedOut = 0;
+        unsigned int currX = 0;
+        unsigned int lineHeight = 0;
+
+        for (NodeHandle child = lineStart; child != lineEnd;
+             child = nextSibling[child]) {
+            unsigned int size = flexBaseSize(child, lineWidth);
+
+            if (grows || shrinks) {
+                uint64_t weight =
+                    grows ? flexGrow[child]
+                          : static_cast<uint64_t>(flexShrink[child]) * size;
+
+                weightSoFar += weight;
+
+                uint64_t share = space * weightSoFar / total - handedOut;
+
+                handedOut += share;
+                size = grows ? size + static_cast<unsigned int>(share)
+                             : size - static_cast<unsigned int>(
+                                          min<uint64_t>(share, size));
+            }
+
+            measure(child, size);
+
+            offsetX[child] = currX;
+            offsetY[child] = currY;
+
+            currX += size + colGap[node];
+            lineHeight = max(lineHeight, height[child]);
+        }
+
+        currY += lineHeight;
+        lineStart = lineEnd;
+
+        if (lineStart != NO_NODE) {
+            currY += rowGap[node];
+        }
+    }
+
+    width[node] = lineWidth;
+    height[node] = currY;
+}
+
+uint64_t LayoutStore::hashContent(NodeHandle node) noexcept {
+    if (flags[node] & CONTENT_HASHED) {
+        return contentHash[node];
+    }
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    hash = mixHash(hash, kind[node]);
+    hash = mixHash(hash,
+                   flags[node] & (INLINE_STYLE | FLEXIBLE_GRID | FLEX_WRAP));
+    hash = mixHash(hash, preferredWidth[node]);
+    hash = mixHash(hash, preferredHeight[node]);
+    hash = mixHash(hash, textSize[node]);
+    hash = mixHash(hash, colGap[node]);
+    hash = mixHash(hash, rowGap[node]);
+    hash = mixHash(hash, childWidth[node]);
+    hash = mixHash(hash, flexGrow[node]);
+    hash = mixHash(hash, flexShrink[node]);
+    hash = mixHash(hash, flexBasis[node]);
+    hash = mixHash(hash, childCount[node]);
+
+    // where words wrap depends on the text itself
+    if (textLines[node] != nullptr) {
+        hash = mixHash(hash, textLines[node]->getTextHash());
+    }
+
+    for (NodeHandle child = firstChild[node]; child != NO_NODE;
+         child = nextSibling[child]) {
+        hash = mixHash(hash, hashContent(child));
+    }
+
+    contentHash[node] = hash;
+    flags[node] |= CONTENT_HASHED;
+
+    return hash;
+}
+
+/**
+ *
+ * Next node after `curr` in a preorder walk of the subtree
+ * under `root`, or `NO_NODE` once it is done
+ */
+static NodeHandle nextInSubtree(const LayoutStore& store, NodeHandle root,
+                                NodeHandle curr) noexcept {
+    if (store.firstChild[curr] != NO_NODE) {
+        return store.firstChild[curr];
+    }
+
+    while (curr != root && store.nextSibling[curr] == NO_NODE) {
+        curr = store.parent[curr];
+    }
+
+    return curr == root ? NO_NODE : store.nextSibling[curr];
+}
+
+bool LayoutStore::restoreMeasured(NodeHandle node,
+                                  unsigned int availableWidth) {
+    uint64_t hash = hashContent(node);
+    unique_lock<mutex> lock(measureCacheLock, defer_lock);
+
+    if (isMeasuringInParallel) {
+        lock.lock();
+    }
+
+    auto it = measureCache.find(mixHash(hash, availableWidth));
+
+    if (it == measureCache.end() || it->second.contentHash != hash ||
+        it->second.availableWidth != availableWidth) {
+        ++measureCacheStats.misses;
+
+        return false;
+    }
+
+    ++measureCacheStats.hits;
+
+    // same hash, so the same shape the entry was walked in
+    auto geometry = it->second.subtree.begin();
+
+    for (NodeHandle curr = node; curr != NO_NODE;
+         curr = nextInSubtree(*this, node, curr), ++geometry) {
+        bool resized =
+            geometry->width != width[curr] || geometry->height != height[curr];
+
+        contentHash[curr] = geometry->contentHash;
+        width[curr] = geometry->width;
+        height[curr] = geometry->height;
+        measuredInWidth[curr] = geometry->measuredInWidth;
+
+        // where the node itself goes is up to its parent, which
+        // may not measure it again if its size stays the same
+        if (curr != node) {
+            offsetX[curr] = geometry->offsetX;
+            offsetY[curr] = geometry->offsetY;
+        }
+
+        flags[curr] &= ~(LAYOUT_DIRTY | CHILD_LAYOUT_DIRTY);
+        flags[curr] |= CONTENT_HASHED | ARRANGE_DIRTY;
+
+        if (firstChild[curr] == NO_NODE && resized) {
+            markPaintDirty(curr);
+        }
+    }
+
+    return true;
+}
+
+void LayoutStore::cacheMeasured(NodeHandle node, unsigned int availableWidth) {
+    unique_lock<mutex> lock(measureCacheLock, defer_lock);
+
+    if (isMeasuringInParallel) {
+        lock.lock();
+    }
+
+    if (measureCache.size() >= MEASURE_CACHE_CAPACITY) {
+        measureCache.clear();
+    }
+
+    uint64_t hash = hashContent(node);
+    MeasureCacheEntry& entry = measureCache[mixHash(hash, availableWidth)];
+
+    entry.contentHash = hash;
+    entry.availableWidth = availableWidth;
+    entry.subtree.clear();
+
+    for (NodeHandle curr = node; curr != NO_NODE;
+         curr = nextInSubtree(*this, node, curr)) {
+        entry.subtree.push_back({contentHash[curr], width[curr], height[curr],
+                                 offsetX[curr], offsetY[curr],
+                                 measuredInWidth[curr]});
+    }
+}
+
+void LayoutStore::measure(NodeHandle node,
+                          unsigned int availableWidth) noexcept {
+    if (!(flags[node] & (LAYOUT_DIRTY | CHILD_LAYOUT_DIRTY)) &&
+        measuredInWidth[node] == availableWidth) {
+        return;
+    }
+
+    bool isCached = isMeasureCacheEnabled && firstChild[node] != NO_NODE;
+
+    if (isCached && restoreMeasured(node, availableWidth)) {
+        return;
+    }
+
+    unsigned int prevWidth = width[node];
+    unsigned int prevHeight = height[node];
+
+    switch (kind[node]) {
+        case FLOW_LAYOUT:
+            measureFlow(node, availableWidth);
+            break;
+        case GRID_LAYOUT:
+            measureGrid(node, availableWidth);
+            break;
+        case TEXT_LAYOUT:
+            measureText(node, availableWidth);
+            break;
+        case FLEX_LAYOUT:
+            measureFlex(node, availableWidth);
+            break;
+        case LIST_LAYOUT:
+            measureList(node, availableWidth);
+            break;
+    }
+
+    measuredInWidth[node] = availableWidth;
+    flags[node] &= ~(LAYOUT_DIRTY | CHILD_LAYOUT_DIRTY);
+    flags[node] |= ARRANGE_DIRTY;
+
+    if (isCached) {
+        cacheMeasured(node, availableWidth);
+    }
+
+    // containers only draw their children, which are flagged
+    // on their own when they change
+    if (firstChild[node] == NO_NODE &&
+        (width[node] != prevWidth || height[node] != prevHeight)) {
+        markPaintDirty(node);
+    }
+}
+
+void LayoutStore::measureChildrenInParallel(
+    NodeHandle node, unsigned int availableWidth) noexcept {
+    if (measurePool == nullptr ||
+        subtreeSize[node] < 2 * parallelMeasureMinNodes) {
+        return;
+    }
+
+    TaskGroup group;
+    NodeHandle runStart = firstChild[node];
+    uint32_t runSize = 0;
+    bool isForked = false;
+    // runs forked from inside a run are joined before it ends
+    bool isOutermost = paintBoundary == NO_NODE;
+
+    if (isOutermost) {
+        isMeasuringInParallel = true;
+    }
+
+    for (NodeHandle child = firstChild[node]; child != NO_NODE;
+         child = nextSibling[child]) {
+        if ((flags[child] & (LAYOUT_DIRTY | CHILD_LAYOUT_DIRTY)) ||
+            measuredInWidth[child] != availableWidth) {
+            runSize += subtreeSize[child];
+        }
+
+        if (runSize < parallelMeasureMinNodes) {
+            continue;
+        }
+
+        NodeHandle runEnd = nextSibling[child];
+
+        measurePool->fork(group, [this, runStart, runEnd, availableWidth] {
+            measureRun(runStart, runEnd, availableWidth);
+        });
+
+        runStart = runEnd;
+        runSize = 0;
+        isForked = true;
+    }
+
+    // the children left over are measured by the caller's loop
+    if (isForked) {
+        measurePool->join(group);
+    }
+
+    if (isOutermost) {
+        isMeasuringInParallel = false;
+    }
+
+    if (!isForked) {
+        return;
+    }
+
+    for (NodeHandle child = firstChild[node]; child != NO_NODE;
+         child = nextSibling[child]) {
+        if (flags[child] & (PAINT_DIRTY | CHILD_PAINT_DIRTY)) {
+            markChildPaintDirty(node);
+
+            break;
+        }
+    }
+}
+
+void LayoutStore::measureRun(NodeHandle first, NodeHandle end,
+                             unsigned int availableWidth) noexcept {
+    NodeHandle prevBoundary = paintBoundary;
+
+    paintBoundary = parent[first];
+
+    for (NodeHandle child = first; child != end; child = nextSibling[child]) {
+        measure(child, availableWidth);
+    }
+
+    paintBoundary = prevBoundary;
+}
+
+void LayoutStore::arrange(NodeHandle node, unsigned int col,
+                          unsigned int row) noexcept {
+    bool moved = col != posX[node] || row != posY[node];
+    // like a subtree laid out on its own before it was appended
+    bool isUnfiled =
+        arrangedIndex != nullptr && !(flags[node] & SPATIALLY_INDEXED);
+
+    if (!(flags[node] & ARRANGE_DIRTY) && !moved && !isUnfiled) {
+        return;
+    }
+
+    if (moved) {
+        markPaintDirty(node);
+    }
+
+    posX[node] = col;
+    posY[node] = row;
+    flags[node] &= ~ARRANGE_DIRTY;
+
+    if (arrangedIndex != nullptr) {
+        arrangedIndex->file(*this, node);
+    }
+
+    for (NodeHandle child = firstChild[node]; child != NO_NODE;
+         child = nextSibling[child]) {
+        arrange(child, col + offsetX[child], row + offsetY[child]);
+    }
+}
+
+bool LayoutStore::relayout(NodeHandle node) noexcept {
+    bool childResized = false;
+
+    if (flags[node] & CHILD_LAYOUT_DIRTY) {
+        for (NodeHandle child = firstChild[node]; child != NO_NODE;
+             child = nextSibling[child]) {
+            if (flags[child] & (LAYOUT_DIRTY | CHILD_LAYOUT_DIRTY)) {
+                childResized = relayout(child) || childResized;
+            }
+        }
+
+        // a flex item's base size can change even when the size
+        // its row gives it stays the same
+        childResized = childResized || kind[node] == FLEX_LAYOUT;
+        flags[node] &= ~CHILD_LAYOUT_DIRTY;
+    }
+
+    if (!(flags[node] & LAYOUT_DIRTY) && !childResized) {
+        return false;
+    }
+
+    unsigned int prevWidth = width[node];
+    unsigned int prevHeight = height[node];
+
+    flags[node] |= LAYOUT_DIRTY;
+    measure(node, measuredInWidth[node]);
+
+    if (width[node] != prevWidth || height[node] != prevHeight) {
+        return true;
+    }
+
+    // same size, so nothing outside of this node moves
+    arrange(node, posX[node], posY[node]);
+
+    return false;
+}
+
+uint32_t LayoutStore::countSubtree(NodeHandle node,
+                                   bool isRecounting) noexcept {
+    // a clean subtree is the same size it was counted at
+    if (!isRecounting &&
+        !(flags[node] & (LAYOUT_DIRTY | CHILD_LAYOUT_DIRTY))) {
+        return subtreeSize[node];
+    }
+
+    uint32_t count = 1;
+
+    for (NodeHandle child = firstChild[node]; child != NO_NODE;
+         child = nextSibling[child]) {
+        count += countSubtree(child, isRecounting);
+    }
+
+    subtreeSize[node] = count;
+
+    return count;
+}
+
+void LayoutStore::layout(NodeHandle node, unsigned int availableWidth) {
+    if (measureThreadCount > 1) {
+        countSubtree(node);
+    }
+
+    if (measurePool == nullptr && measureThreadCount > 1 &&
+        subtreeSize[node] >= 2 * parallelMeasureMinNodes) {
+        measurePool = make_unique<WorkStealingPool>(measureThreadCount);
+    }
+
+    arrangedIndex = flags[node] & SPATIALLY_INDEXED ? findSpatialIndex(node)
+                                                    : nullptr;
+
+    if ((flags[node] & LAYOUT_DIRTY) ||
+        measuredInWidth[node] != availableWidth) {
+        measure(node, availableWidth);
+        arrange(node, posX[node], posY[node]);
+    } else if ((flags[node] & CHILD_LAYOUT_DIRTY) && relayout(node)) {
+        arrange(node, posX[node], posY[node]);
+    }
+
+    arrangedIndex = nullptr;
+}
+
+void LayoutStore::markLayoutDirty(NodeHandle node) noexcept {
+    flags[node] |= LAYOUT_DIRTY;
+    flags[node] &= ~CONTENT_HASHED;
+
+    // an ancestor flagged already dropped its hash back then
+    for (NodeHandle ancestor = parent[node];
+         ancestor != NO_NODE && !(flags[ancestor] & CHILD_LAYOUT_DIRTY);
+         ancestor = parent[ancestor]) {
+        flags[ancestor] |= CHILD_LAYOUT_DIRTY;
+        flags[ancestor] &= ~CONTENT_HASHED;
+    }
+}
+
+void LayoutStore::setIsMeasureCacheEnabled(bool enabled) {
+    isMeasureCacheEnabled = enabled;
+
+    if (!enabled) {
+        measureCache.clear();
+    }
+}
+
+MeasureCacheStats LayoutStore::getMeasureCacheStats() const noexcept {
+    return measureCacheStats;
+}
+
+void LayoutStore::resetMeasureCacheStats() noexcept {
+    measureCacheStats = {0, 0};
+}
+
+void LayoutStore::setMeasureThreadCount(size_t threadCount) {
+    bool wasCounting = measureThreadCount > 1;
+
+    measureThreadCount = max<size_t>(threadCount, 1);
+    measurePool.reset();
+
+    if (wasCounting || measureThreadCount == 1) {
+        return;
+    }
+
+    // trees laid out uncounted until now may be clean yet miscounted
+    for (NodeHandle handle = 0; handle < nodes.size(); ++handle) {
+        if (nodes[handle] != nullptr && parent[handle] == NO_NODE) {
+            countSubtree(handle, true);
+        }
+    }
+}
+
+size_t LayoutStore::getMeasureThreadCount() const noexcept {
+    return measureThreadCount;
+}
+
+void LayoutStore::setParallelMeasureMinNodes(uint32_t minNodes) noexcept {
+    parallelMeasureMinNodes = max<uint32_t>(minNodes, 1);
+}
+
+void LayoutStore::markPaintDirty(NodeHandle node) noexcept {
+    flags[node] |= PAINT_DIRTY;
+
+    markChildPaintDirty(parent[node]);
+}
+
+void LayoutStore::markChildPaintDirty(NodeHandle node) noexcept {
+    for (NodeHandle ancestor = node; ancestor != NO_NODE &&
+                                     ancestor != paintBoundary &&
+                                     !(flags[ancestor] & CHILD_PAINT_DIRTY);
+         ancestor = parent[ancestor]) {
+        flags[ancestor] |= CHILD_PAINT_DIRTY;
+    }
+}
+
+SpatialIndex* LayoutStore::findSpatialIndex(NodeHandle node) const noexcept {
+    while (parent[node] != NO_NODE) {
+        node = parent[node];
+    }
+
+    auto it = spatialIndexes.find(node);
+
+    return it == spatialIndexes.end() ? nullptr : it->second.get();
+}
+
+void LayoutStore::unfileSubtree(NodeHandle node) noexcept {
+    SpatialIndex* index = findSpatialIndex(node);
+
+    for (NodeHandle curr = node; curr != NO_NODE;
+         curr = nextInSubtree(*this, node, curr)) {
+        if (index != nullptr) {
+            index->unfile(*this, curr);
+        } else {
+            indexStamp[curr] = 0;
+            flags[curr] &= ~SPATIALLY_INDEXED;
+        }
+    }
+}
+
+void LayoutStore::setIsSpatiallyIndexed(NodeHandle root, bool indexed) {
+    assert(parent[root] == NO_NODE ||
+           !"LayoutStore::setIsSpatiallyIndexed() received a node that "
+           "isn't a root");
+
+    if (!indexed) {
+        unfileSubtree(root);
+        spatialIndexes.erase(root);
+
+        return;
+    }
+
+    unique_ptr<SpatialIndex>& index = spatialIndexes[root];
+
+    if (index) {
+        return;
+    }
+
+    index = make_unique<SpatialIndex>(root);
+
+    // where the tree was last laid out, `arrange()` files the
+    // nodes it moves again
+    for (NodeHandle curr = root; curr != NO_NODE;
+         curr = nextInSubtree(*this, root, curr)) {
+        index->file(*this, curr);
+    }
+}
+
+const SpatialIndex* LayoutStore::getSpatialIndex(NodeHandle root) const
+    noexcept {
+    auto it = spatialIndexes.find(root);
+
+    return it == spatialIndexes.end() ? nullptr : it->second.get();
+}
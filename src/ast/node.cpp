@@ -1,240 +1,357 @@
 #include <ast/node.hpp>
+#include <ast/spatial.hpp>
 #include <renderer.hpp>
 
-Node::Node() : posX(0), posY(0), width(0), height(0){};
+/**
+ *
+ * Node the slot at `handle` belongs to, or nullptr for `NO_NODE`
+ */
+static Node::NodePtr nodeAt(NodeHandle handle) noexcept {
+    return handle == NO_NODE ? nullptr : getLayoutStore().nodes[handle];
+}
+
+Node::Node() : handle(getLayoutStore().create(this, FLOW_LAYOUT)) {}
 
-Node::Node(unsigned int col) : posX(col), posY(0), width(0), height(0){};
+Node::Node(unsigned int col)
+    : handle(getLayoutStore().create(this, FLOW_LAYOUT)) {
+    setPosX(col);
+}
 
 Node::Node(unsigned int col, unsigned int row)
-    : posX(col), posY(row), width(0), height(0) {}
+    : handle(getLayoutStore().create(this, FLOW_LAYOUT)) {
+    setPosX(col);
+    setPosY(row);
+}
 
-Node::~Node() = default;
+Node::~Node() {
+    // recycled nodes left in a pool have no slot
+    if (handle != NO_NODE) {
+        getLayoutStore().release(handle);
+    }
+}
 
 NodeRenderStyle Node::nodeRenderStyle() const noexcept {
-    return NodeRenderStyle::BLOCK;
+    return getLayoutStore().flags[handle] & INLINE_STYLE
+               ? NodeRenderStyle::INLINE
+               : NodeRenderStyle::BLOCK;
 }
 
-bool Node::canHaveChildren() const noexcept { return true; }
+void Node::setNodeRenderStyle(NodeRenderStyle style) noexcept {
+    LayoutStore& store = getLayoutStore();
+
+    if (style == NodeRenderStyle::INLINE) {
+        store.flags[handle] |= INLINE_STYLE;
+    } else {
+        store.flags[handle] &= ~INLINE_STYLE;
+    }
+
+    markLayoutDirty();
+}
 
-unsigned int Node::getWidth() const noexcept { return width; }
+void Node::setLayoutKind(LayoutKind kind) noexcept {
+    getLayoutStore().kind[handle] = kind;
+
+    markLayoutDirty();
+}
+
+bool Node::canHaveChildren() const noexcept { return true; }
 
-void Node::setWidth(unsigned int w) { width = w; }
+NodeHandle Node::getHandle() const noexcept { return handle; }
 
-unsigned int Node::getHeight() const noexcept { return height; }
+const string& Node::getKey() const noexcept { return key; }
 
-void Node::setHeight(unsigned int h) { height = h; }
+void Node::setKey(const string& k) { key = k; }
 
-unsigned int Node::getPosX() const noexcept { return posX; }
+void Node::patchFrom(const Node& node) {
+    LayoutStore& store = getLayoutStore();
 
-void Node::setPosX(unsigned int col) { posX = col; }
+    if (store.preferredWidth[handle] != store.preferredWidth[node.handle] ||
+        store.preferredHeight[handle] != store.preferredHeight[node.handle]) {
+        store.preferredWidth[handle] = store.preferredWidth[node.handle];
+        store.preferredHeight[handle] = store.preferredHeight[node.handle];
 
-unsigned int Node::getPosY() const noexcept { return posY; }
+        markLayoutDirty();
+    }
 
-void Node::setPosY(unsigned int row) { posY = row; }
+    if (store.flexGrow[handle] != store.flexGrow[node.handle] ||
+        store.flexShrink[handle] != store.flexShrink[node.handle] ||
+        store.flexBasis[handle] != store.flexBasis[node.handle]) {
+        store.flexGrow[handle] = store.flexGrow[node.handle];
+        store.flexShrink[handle] = store.flexShrink[node.handle];
+        store.flexBasis[handle] = store.flexBasis[node.handle];
 
-Node::NodePtr Node::getParent() const noexcept { return parent; }
+        markFlexItemDirty();
+    }
+}
 
-const vector<Node::NodePtr>& Node::getChildren() const noexcept {
-    return children;
+void Node::recycle() noexcept {
+    getLayoutStore().release(handle);
+    handle = NO_NODE;
+    key.clear();
 }
 
-void Node::assertChildIsValid(NodePtr) const {}
+void Node::reuse() {
+    assert(handle == NO_NODE || !"Node::reuse() received a node in use");
 
-void Node::setAsParentOfChild(NodePtr child) {
-    child->parent = shared_from_this();
+    handle = getLayoutStore().create(this, FLOW_LAYOUT);
 }
 
-void Node::onChildRemoved(size_t idx, NodePtr child) {
-    if (children.empty()) {
-        setWidth(0);
-        setHeight(0);
+void Node::markFlexItemDirty() noexcept {
+    markLayoutDirty();
 
-        return;
+    // the row the node is in has to be solved again even if the
+    // node's own size stays the same
+    if (NodePtr parent = getParent()) {
+        parent->markLayoutDirty();
     }
+}
 
-    unsigned int heightOfRemovedChild = child->getHeight();
-    unsigned int largestWidth = 0;
+unsigned int Node::getFlexGrow() const noexcept {
+    return getLayoutStore().flexGrow[handle];
+}
 
-    for (NodePtr node : children) {
-        unsigned nodeRealWidth = node->getPosX() + node->getWidth();
+void Node::setFlexGrow(unsigned int grow) {
+    getLayoutStore().flexGrow[handle] = grow;
 
-        if (largestWidth < nodeRealWidth) {
-            largestWidth = nodeRealWidth;
-        }
-    }
+    markFlexItemDirty();
+}
 
-    for (size_t i = idx, l = children.size(); i < l; ++i) {
-        NodePtr node = children.at(i);
+unsigned int Node::getFlexShrink() const noexcept {
+    return getLayoutStore().flexShrink[handle];
+}
 
-        node->setPosX(node->getPosX() - heightOfRemovedChild);
-    }
+void Node::setFlexShrink(unsigned int shrink) {
+    getLayoutStore().flexShrink[handle] = shrink;
 
-    setWidth(largestWidth);
-    setHeight(getHeight() - heightOfRemovedChild);
+    markFlexItemDirty();
 }
 
-void Node::onChildAppended() {
-    assert(!children.empty() ||
-           !"Node::onChildAppended() called when children is empty().");
+unsigned int Node::getFlexBasis() const noexcept {
+    return getLayoutStore().flexBasis[handle];
+}
 
-    size_t childrenSize = children.size();
-    NodePtr appendedChild = children.at(childrenSize - 1);
+void Node::setFlexBasis(unsigned int basis) {
+    getLayoutStore().flexBasis[handle] = basis;
 
-    appendedChild->setPosX(getPosX());
-    appendedChild->setPosY(getPosY());
+    markFlexItemDirty();
+}
 
-    if (childrenSize > 1) {
-        NodePtr prevSibling = children.at(childrenSize - 2);
+unsigned int Node::getWidth() const noexcept {
+    return getLayoutStore().width[handle];
+}
 
-        switch (appendedChild->nodeRenderStyle()) {
-            case NodeRenderStyle::BLOCK: {
-                appendedChild->setPosY(prevSibling->getPosY() +
-                                       prevSibling->getHeight());
-                setHeight(getHeight() + appendedChild->getHeight());
-            }; break;
-            case NodeRenderStyle::INLINE: {
-                appendedChild->setPosX(prevSibling->getPosX() +
-                                       prevSibling->getWidth());
+void Node::setWidth(unsigned int w) {
+    LayoutStore& store = getLayoutStore();
 
-                if (getHeight() < appendedChild->getHeight()) {
-                    setHeight(getHeight() +
-                              (appendedChild->getHeight() - getHeight()));
-                }
-            }; break;
-        }
-    } else {
-        setHeight(appendedChild->getHeight());
-    }
+    // the size is left to the next layout, which only resizes
+    // the parent if it ends up different from the measured one
+    store.preferredWidth[handle] = w;
 
-    unsigned int appendedChildRealWidth =
-        appendedChild->getPosX() + appendedChild->getWidth();
+    markLayoutDirty();
+}
 
-    // TODO: Have this wrap to next line if this exceeds
-    // screen size.
-    if (getWidth() < appendedChildRealWidth) {
-        if (appendedChildRealWidth > getScreen().getWidth()) {
-            appendedChild->setPosX(getPosX());
-            appendedChild->setPosY(getHeight());
-            setHeight(getHeight() + appendedChild->getHeight());
-        } else {
-            setWidth(appendedChildRealWidth);
-        }
-    }
+unsigned int Node::getHeight() const noexcept {
+    return getLayoutStore().height[handle];
+}
 
-    appendedChild->updateChildrenDimensionsOnChange();
+void Node::setHeight(unsigned int h) {
+    LayoutStore& store = getLayoutStore();
 
-    /** === Update the parents' and children's dimensions or something */
-    NodePtr prnt = getParent();
+    store.preferredHeight[handle] = h;
 
-    if (prnt) {
-        prnt->updateParentDimensionsOnChildChange(shared_from_this());
-    }
+    markLayoutDirty();
 }
 
-void Node::updateChildrenDimensionsOnChange() {
-    /**
-     *
-     * TODO: All these adjustment logic should be done every time that there's
-     * a change in dimensions in any node that's related to the affected
-     * node AND make it responsive if possible.
-     */
-    const unsigned int cachedInitialPosX = getPosX();
-    unsigned int currPosY = getPosY();
-    unsigned int currPosX = getPosX();
+unsigned int Node::getPosX() const noexcept {
+    return getLayoutStore().posX[handle];
+}
 
-    for (size_t i = 0, l = children.size(); i < l; ++i) {
-        auto& c = children.at(i);
+void Node::setPosX(unsigned int col) { getLayoutStore().posX[handle] = col; }
 
-        c->setPosY(currPosY);
-        c->setPosX(currPosX);
+unsigned int Node::getPosY() const noexcept {
+    return getLayoutStore().posY[handle];
+}
 
-        if (i < l - 1) {
-            auto& nextC = children.at(i + 1);
+void Node::setPosY(unsigned int row) { getLayoutStore().posY[handle] = row; }
 
-            // shit (doesnt take order and relativity into account, but
-            // whatever) and other stuff
-            switch (nextC->nodeRenderStyle()) {
-                case NodeRenderStyle::BLOCK: {
-                    currPosY += c->getHeight();
-                }; break;
-                case NodeRenderStyle::INLINE: {
-                    currPosX += c->getWidth();
-                }; break;
-            }
+Node::NodePtr Node::getParent() const noexcept {
+    return nodeAt(getLayoutStore().parent[handle]);
+}
 
-            if (currPosX >= getWidth() + cachedInitialPosX) {
-                currPosX = cachedInitialPosX;
-                currPosY += c->getHeight();
-            }
-        } else {
-            switch (c->nodeRenderStyle()) {
-                case NodeRenderStyle::BLOCK: {
-                    currPosY += c->getHeight();
-                }; break;
-                case NodeRenderStyle::INLINE: {
-                    currPosX += c->getWidth();
-                }; break;
-            }
+Node::NodePtr Node::getFirstChild() const noexcept {
+    return nodeAt(getLayoutStore().firstChild[handle]);
+}
 
-            if (currPosX >= getWidth() + cachedInitialPosX) {
-                currPosX = cachedInitialPosX;
-                currPosY += c->getHeight();
-            }
-        }
+Node::NodePtr Node::getLastChild() const noexcept {
+    return nodeAt(getLayoutStore().lastChild[handle]);
+}
+
+Node::NodePtr Node::getPrevSibling() const noexcept {
+    return nodeAt(getLayoutStore().prevSibling[handle]);
+}
+
+Node::NodePtr Node::getNextSibling() const noexcept {
+    return nodeAt(getLayoutStore().nextSibling[handle]);
+}
+
+size_t Node::getChildCount() const noexcept {
+    return getLayoutStore().childCount[handle];
+}
+
+Node::NodePtr Node::getChildAt(size_t idx) const {
+    assert(idx < getChildCount() ||
+           !"Passed in a size_t idx >= getChildCount() at Node::getChildAt().");
+
+    return nodeAt(getLayoutStore().getChildAt(handle, idx));
+}
+
+void Node::assertChildIsValid(NodePtr) const {}
+
+void Node::onChildRemoved(size_t, NodePtr) {}
+
+void Node::layout(unsigned int availableWidth) {
+    getLayoutStore().layout(handle, availableWidth);
+}
+
+void Node::paint(ostringstream* buf) {
+    eraseStalePaint(buf);
+    paintDirtyNodes(buf);
+}
+
+void Node::setIsSpatiallyIndexed(bool indexed) {
+    getLayoutStore().setIsSpatiallyIndexed(handle, indexed);
+}
+
+Node::NodePtr Node::hitTest(unsigned int col, unsigned int row) const {
+    const LayoutStore& store = getLayoutStore();
+    const SpatialIndex* index = store.getSpatialIndex(handle);
+
+    return index == nullptr ? nullptr
+                            : nodeAt(index->hitTest(store, col, row));
+}
 
-        c->updateChildrenDimensionsOnChange();
+void Node::findNodesIn(unsigned int col, unsigned int row, unsigned int w,
+                       unsigned int h, vector<NodePtr>& nodes) const {
+    const LayoutStore& store = getLayoutStore();
+    const SpatialIndex* index = store.getSpatialIndex(handle);
+    vector<NodeHandle> handles;
+
+    if (index == nullptr) {
+        return;
+    }
+
+    index->findNodesIn(store, col, row, w, h, handles);
+
+    for (NodeHandle found : handles) {
+        nodes.push_back(nodeAt(found));
     }
 }
 
-void Node::updateParentDimensionsOnChildChange(NodePtr childCaller) {
-    unsigned int childCallerRealHeight =
-        childCaller->getPosY() + childCaller->getHeight();
+void Node::eraseStalePaint(ostringstream* buf) const {
+    const LayoutStore& store = getLayoutStore();
+    uint16_t flags = store.flags[handle];
+
+    if (flags & PAINT_DIRTY) {
+        if (!(flags & PAINTED)) {
+            return;
+        }
+
+        unsigned int w = store.paintedWidth[handle];
+        unsigned int h = store.paintedHeight[handle];
+        string blank(w, ' ');
+
+        for (unsigned int row = 0; row < h && w > 0; ++row) {
+            moveCursorTo(buf, store.paintedX[handle],
+                         store.paintedY[handle] + row);
+            *buf << blank;
+        }
 
-    if (getHeight() < childCallerRealHeight) {
-        setHeight(childCallerRealHeight);
+        return;
     }
 
-    unsigned int childCallerRealWidth =
-        childCaller->getPosX() + childCaller->getWidth();
+    if (!(flags & CHILD_PAINT_DIRTY)) {
+        return;
+    }
 
-    if (getWidth() < childCallerRealWidth) {
-        setWidth(childCallerRealWidth);
+    for (NodePtr child = getFirstChild(); child != nullptr;
+         child = child->getNextSibling()) {
+        child->eraseStalePaint(buf);
     }
+}
+
+void Node::paintDirtyNodes(ostringstream* buf) {
+    uint16_t& flags = getLayoutStore().flags[handle];
 
-    updateChildrenDimensionsOnChange();
+    if (flags & PAINT_DIRTY) {
+        render(buf);
+        markPainted();
 
-    NodePtr parent = getParent();
+        return;
+    }
 
-    // Base case
-    if (parent == nullptr) {
+    if (!(flags & CHILD_PAINT_DIRTY)) {
         return;
     }
 
-    parent->updateParentDimensionsOnChildChange(shared_from_this());
+    for (NodePtr child = getFirstChild(); child != nullptr;
+         child = child->getNextSibling()) {
+        child->paintDirtyNodes(buf);
+    }
+
+    flags &= ~CHILD_PAINT_DIRTY;
+}
+
+void Node::markPainted() noexcept {
+    LayoutStore& store = getLayoutStore();
+
+    store.paintedX[handle] = store.posX[handle];
+    store.paintedY[handle] = store.posY[handle];
+    store.paintedWidth[handle] = store.width[handle];
+    store.paintedHeight[handle] = store.height[handle];
+    store.flags[handle] &= ~(PAINT_DIRTY | CHILD_PAINT_DIRTY);
+    store.flags[handle] |= PAINTED;
+
+    for (NodePtr child = getFirstChild(); child != nullptr;
+         child = child->getNextSibling()) {
+        child->markPainted();
+    }
+}
+
+bool Node::isLayoutDirty() const noexcept {
+    return getLayoutStore().flags[handle] & LAYOUT_DIRTY;
+}
+
+void Node::markLayoutDirty() noexcept {
+    getLayoutStore().markLayoutDirty(handle);
+}
+
+bool Node::isPaintDirty() const noexcept {
+    return getLayoutStore().flags[handle] & PAINT_DIRTY;
+}
+
+void Node::markPaintDirty() noexcept {
+    getLayoutStore().markPaintDirty(handle);
 }
 
 void Node::appendChild(NodePtr child) {
     assert(canHaveChildren() || !"Node cannot have children");
+    assert(child->getParent() == nullptr ||
+           !"Node::appendChild() received a node that has a parent");
     assertChildIsValid(child);
 
-    setAsParentOfChild(child);
-
-    children.push_back(move(child));
-
-    onChildAppended();
+    getLayoutStore().appendChild(handle, child->handle);
 }
 
 void Node::removeChildAt(size_t idx) {
-    assert(!children.empty() ||
+    assert(getChildCount() > 0 ||
            !"Called Node::removeChildAt() with no children.");
     assert(
-        idx < children.size() ||
+        idx < getChildCount() ||
         !"Passed in a size_t idx > children.size() at Node::removeChildAt().");
 
-    NodePtr removedChild = children.at(idx);
-
-    children.erase(children.begin() + idx);
+    NodePtr removedChild = getChildAt(idx);
 
+    getLayoutStore().removeChild(handle, removedChild->handle);
     onChildRemoved(idx, removedChild);
 }
 
@@ -243,14 +360,12 @@ void Node::removeAllChildren() noexcept {
            !"Called Node::removeAllChildren() on a node that cannot have "
            "children.");
 
-    children.clear();
-
-    setWidth(0);
-    setHeight(0);
+    getLayoutStore().removeAllChildren(handle);
 }
 
 void ContainerNode::render(ostringstream* buf) const {
-    for (auto node : children) {
+    for (NodePtr node = getFirstChild(); node != nullptr;
+         node = node->getNextSibling()) {
         node->render(buf);
     }
 }
@@ -259,253 +374,275 @@ NodeTypes ContainerNode::nodeType() const noexcept {
     return NodeTypes::CONTAINER;
 }
 
-GridNode::GridNode() : colGap(4), rowGap(2), childWidth(0) {
+/**
+ *
+ * Fills in the grid's slot of the `LayoutStore`
+ */
+static void initializeGrid(NodeHandle handle, unsigned int childW,
+                           unsigned int colGap, unsigned int rowGap) {
+    LayoutStore& store = getLayoutStore();
+
+    store.childWidth[handle] = childW;
+    store.colGap[handle] = colGap;
+    store.rowGap[handle] = rowGap;
+    store.flags[handle] &= ~FLEXIBLE_GRID;
+}
+
+GridNode::GridNode() {
+    setLayoutKind(GRID_LAYOUT);
+    initializeGrid(getHandle(), 0, 4, 2);
     setWidth(getScreen().getWidth());
 }
 
-GridNode::GridNode(unsigned int w) : colGap(4), rowGap(2), childWidth(0) {
+GridNode::GridNode(unsigned int w) {
+    setLayoutKind(GRID_LAYOUT);
+    initializeGrid(getHandle(), 0, 4, 2);
     setWidth(w);
 }
 
-GridNode::GridNode(unsigned int w, unsigned int childW)
-    : colGap(4), rowGap(2), childWidth(childW) {
+GridNode::GridNode(unsigned int w, unsigned int childW) {
+    setLayoutKind(GRID_LAYOUT);
+    initializeGrid(getHandle(), childW, 4, 2);
     setWidth(w);
-    assert(childW <= getWidth() ||
+    assert(childW <= getLayoutStore().preferredWidth[getHandle()] ||
            !"child width should be <= grid container's width.");
 }
 
-GridNode::GridNode(unsigned int w, unsigned int childW, unsigned int colGap)
-    : colGap(colGap), rowGap(2), childWidth(childW) {
+GridNode::GridNode(unsigned int w, unsigned int childW, unsigned int colGap) {
+    setLayoutKind(GRID_LAYOUT);
+    initializeGrid(getHandle(), childW, colGap, 2);
     setWidth(w);
-    assert(childW <= getWidth() ||
+    assert(childW <= getLayoutStore().preferredWidth[getHandle()] ||
            !"child width should be <= grid container's width.");
 }
 
 GridNode::GridNode(unsigned int w, unsigned int childW, unsigned int colGap,
-                   unsigned int rowGap)
-    : colGap(colGap), rowGap(rowGap), childWidth(childW) {
+                   unsigned int rowGap) {
+    setLayoutKind(GRID_LAYOUT);
+    initializeGrid(getHandle(), childW, colGap, rowGap);
     setWidth(w);
-    assert(childW <= getWidth() ||
+    assert(childW <= getLayoutStore().preferredWidth[getHandle()] ||
            !"child width should be <= grid container's width.");
 }
 
-void GridNode::removeAllChildren() noexcept {
-    children.clear();
+void GridNode::reuse() { reuse(getScreen().getWidth()); }
 
-    setHeight(0);
+void GridNode::reuse(unsigned int w, unsigned int childW, unsigned int colGap,
+                     unsigned int rowGap) {
+    Node::reuse();
+    setLayoutKind(GRID_LAYOUT);
+    initializeGrid(getHandle(), childW, colGap, rowGap);
+    setWidth(w);
+    assert(childW <= getLayoutStore().preferredWidth[getHandle()] ||
+           !"child width should be <= grid container's width.");
 }
 
-unsigned int GridNode::getColGap() const noexcept { return colGap; }
+unsigned int GridNode::getColGap() const noexcept {
+    return getLayoutStore().colGap[getHandle()];
+}
 
 void GridNode::setColGap(unsigned int c) {
     assert(c > 0 || !"column gap must be > 0");
-    colGap = c;
+    getLayoutStore().colGap[getHandle()] = c;
+
+    markLayoutDirty();
 }
 
-unsigned int GridNode::getRowGap() const noexcept { return rowGap; }
+unsigned int GridNode::getRowGap() const noexcept {
+    return getLayoutStore().rowGap[getHandle()];
+}
 
 void GridNode::setRowGap(unsigned int r) {
-    assert(r > 0 || !"row gap must be > 0");
-    rowGap = r;
+    getLayoutStore().rowGap[getHandle()] = r;
+
+    markLayoutDirty();
 }
 
-bool GridNode::isFlexible() const noexcept { return flexible; }
+bool GridNode::isFlexible() const noexcept {
+    return getLayoutStore().flags[getHandle()] & FLEXIBLE_GRID;
+}
 
-void GridNode::setIsFlexible(bool f) noexcept { flexible = f; }
+void GridNode::patchFrom(const Node& node) {
+    LayoutStore& store = getLayoutStore();
+    NodeHandle h = getHandle();
+    NodeHandle other = node.getHandle();
 
-void GridNode::onChildAppended() {
-    assert(!children.empty() ||
-           !"GridNode::onChildAppended() called when children is empty().");
+    Node::patchFrom(node);
 
-    size_t childrenSize = children.size();
-    NodePtr appendedChild = children.at(childrenSize - 1);
+    if (store.colGap[h] != store.colGap[other] ||
+        store.rowGap[h] != store.rowGap[other] ||
+        store.childWidth[h] != store.childWidth[other] ||
+        isFlexible() != static_cast<const GridNode&>(node).isFlexible()) {
+        initializeGrid(h, store.childWidth[other], store.colGap[other],
+                       store.rowGap[other]);
+        setIsFlexible(static_cast<const GridNode&>(node).isFlexible());
+    }
+}
 
-    if (!flexible) {
-        unsigned int w = appendedChild->getWidth() == 0
-                             ? getWidth()
-                             : appendedChild->getWidth();
+void GridNode::setIsFlexible(bool f) noexcept {
+    LayoutStore& store = getLayoutStore();
 
-        appendedChild->setWidth(childWidth == 0 ? w : childWidth);
+    if (f) {
+        store.flags[getHandle()] |= FLEXIBLE_GRID;
+    } else {
+        store.flags[getHandle()] &= ~FLEXIBLE_GRID;
     }
 
-    appendedChild->setPosX(getPosX());
-    appendedChild->setPosY(getPosY());
-
-    if (childrenSize == 1) {
-        if (appendedChild->getWidth() > getWidth()) {
-            appendedChild->setWidth(getWidth());
-        }
+    markLayoutDirty();
+}
 
-        setHeight(appendedChild->getHeight());
-    } else {
-        NodePtr prevSiblingOfAppendedChild = children.at(childrenSize - 2);
-        unsigned int prevSiblingRealWidth =
-            prevSiblingOfAppendedChild->getPosX() +
-            prevSiblingOfAppendedChild->getWidth() + colGap;
-
-        // have the appended child take the remaining width if
-        // it has no defined width
-        if (flexible && prevSiblingRealWidth < getWidth()) {
-            if (appendedChild->getWidth() == 0 ||
-                prevSiblingRealWidth + appendedChild->getWidth() > getWidth()) {
-                appendedChild->setWidth(getWidth() - prevSiblingRealWidth);
-            }
-        }
+/**
+ *
+ * Fills in the flex container's slot of the `LayoutStore`
+ */
+static void initializeFlex(NodeHandle handle, unsigned int colGap,
+                           unsigned int rowGap) {
+    LayoutStore& store = getLayoutStore();
 
-        // if overflow
-        if (prevSiblingRealWidth + appendedChild->getWidth() > getWidth()) {
-            appendedChild->setPosX(getPosX());
-            appendedChild->setPosY(prevSiblingOfAppendedChild->getPosY() +
-                                   prevSiblingOfAppendedChild->getHeight() +
-                                   rowGap);
+    store.colGap[handle] = colGap;
+    store.rowGap[handle] = rowGap;
+    store.flags[handle] &= ~FLEX_WRAP;
+}
 
-            setHeight(appendedChild->getPosY() + appendedChild->getHeight());
-        } else {
-            unsigned int prevSiblingHeight =
-                prevSiblingOfAppendedChild->getPosY() +
-                prevSiblingOfAppendedChild->getHeight();
-            unsigned int appendedChildHeight =
-                appendedChild->getPosY() + appendedChild->getHeight();
-            unsigned int tallestHeight = prevSiblingHeight > appendedChildHeight
-                                             ? prevSiblingHeight
-                                             : appendedChildHeight;
-
-            for (size_t i = 0, l = childrenSize - 1; i < l; ++i) {
-                NodePtr child = children.at(i);
-                unsigned int childHeight =
-                    child->getPosY() + child->getHeight();
-
-                if (childHeight > tallestHeight) {
-                    tallestHeight = childHeight;
-                }
-            }
+FlexNode::FlexNode() {
+    setLayoutKind(FLEX_LAYOUT);
+    initializeFlex(getHandle(), 0, 0);
+    setWidth(getScreen().getWidth());
+}
 
-            setHeight(tallestHeight);
+FlexNode::FlexNode(unsigned int w) {
+    setLayoutKind(FLEX_LAYOUT);
+    initializeFlex(getHandle(), 0, 0);
+    setWidth(w);
+}
 
-            appendedChild->setPosX(prevSiblingRealWidth);
-            appendedChild->setPosY(prevSiblingOfAppendedChild->getPosY());
-        }
-    }
+FlexNode::FlexNode(unsigned int w, unsigned int colGap, unsigned int rowGap) {
+    setLayoutKind(FLEX_LAYOUT);
+    initializeFlex(getHandle(), colGap, rowGap);
+    setWidth(w);
+}
 
-    appendedChild->updateChildrenDimensionsOnChange();
+void FlexNode::patchFrom(const Node& node) {
+    const FlexNode& flex = static_cast<const FlexNode&>(node);
 
-    /** === Update the parents' and children's dimensions or something */
-    NodePtr prnt = getParent();
+    Node::patchFrom(node);
 
-    if (prnt) {
-        prnt->updateParentDimensionsOnChildChange(shared_from_this());
+    if (getColGap() != flex.getColGap() || getRowGap() != flex.getRowGap() ||
+        isWrapping() != flex.isWrapping()) {
+        initializeFlex(getHandle(), flex.getColGap(), flex.getRowGap());
+        setIsWrapping(flex.isWrapping());
     }
 }
 
-void GridNode::updateParentDimensionsOnChildChange(NodePtr childCaller) {
-    unsigned int childCallerRealWidth =
-        childCaller->getPosX() + childCaller->getWidth();
-
-    if (getWidth() < childCallerRealWidth) {
-        if (children.size() == 1 || !flexible) {
-            childCaller->setWidth(childWidth == 0
-                                      ? (childCallerRealWidth - getWidth())
-                                      : childWidth);
-        } else if (flexible && children.size() > 1) {
-            childCaller->setWidth(childCallerRealWidth - getWidth());
-        }
-    }
+unsigned int FlexNode::getColGap() const noexcept {
+    return getLayoutStore().colGap[getHandle()];
+}
 
-    unsigned int childCallerRealHeight =
-        childCaller->getPosY() + childCaller->getHeight();
+void FlexNode::setColGap(unsigned int c) {
+    getLayoutStore().colGap[getHandle()] = c;
 
-    if (getHeight() < childCallerRealHeight) {
-        setHeight(childCallerRealHeight);
-    }
+    markLayoutDirty();
+}
 
-    updateChildrenDimensionsOnChange();
+unsigned int FlexNode::getRowGap() const noexcept {
+    return getLayoutStore().rowGap[getHandle()];
+}
 
-    NodePtr parent = getParent();
+void FlexNode::setRowGap(unsigned int r) {
+    getLayoutStore().rowGap[getHandle()] = r;
 
-    // Base case
-    if (parent == nullptr) {
-        return;
-    }
+    markLayoutDirty();
+}
 
-    parent->updateParentDimensionsOnChildChange(shared_from_this());
+bool FlexNode::isWrapping() const noexcept {
+    return getLayoutStore().flags[getHandle()] & FLEX_WRAP;
 }
 
-void GridNode::updateChildrenDimensionsOnChange() {
-    /**
-     *
-     * TODO: All these adjustment logic should be done every time that there's
-     * a change in dimensions in any node that's related to the affected
-     * node AND make it responsive if possible.
-     */
-    const unsigned int cachedInitialPosX = getPosX();
-    unsigned int currPosY = getPosY();
-    unsigned int currPosX = getPosX();
+void FlexNode::setIsWrapping(bool w) noexcept {
+    LayoutStore& store = getLayoutStore();
 
-    for (size_t i = 0, l = children.size(); i < l; ++i) {
-        auto& c = children.at(i);
+    if (w) {
+        store.flags[getHandle()] |= FLEX_WRAP;
+    } else {
+        store.flags[getHandle()] &= ~FLEX_WRAP;
+    }
 
-        c->setPosY(currPosY);
-        c->setPosX(currPosX);
+    markLayoutDirty();
+}
 
-        if (i == l - 1) {
-            if (!flexible) {
-                currPosX += childWidth == 0 ? c->getWidth() : childWidth;
-            } else if (currPosX < getWidth() + cachedInitialPosX) {
-                currPosX += c->getWidth();
-            }
-        } else {
-            auto& nextC = children.at(i + 1);
+bool LeafNode::canHaveChildren() const noexcept { return false; }
 
-            if (!flexible) {
-                currPosX += childWidth == 0 ? c->getWidth() + colGap
-                                            : childWidth + colGap;
-            } else if (currPosX < getWidth() + cachedInitialPosX) {
-                currPosX += c->getWidth() + colGap;
-            }
+NodeTypes LeafNode::nodeType() const noexcept { return NodeTypes::LEAF; }
 
-            if (currPosX + nextC->getWidth() > getWidth() + cachedInitialPosX) {
-                currPosX = cachedInitialPosX;
-                currPosY += c->getHeight() + rowGap;
-            }
+/**
+ *
+ * Bytes of `text`, from byte `start` on, that fit in `columns`
+ * columns, but at least one character
+ */
+static size_t bytesInColumns(const string& text, size_t start,
+                             unsigned int columns) {
+    size_t i = start;
+    unsigned int usedColumns = 0;
+
+    while (i < text.size()) {
+        char32_t codePoint;
+        size_t len = decodeUtf8(text, i, codePoint);
+        unsigned int w = codePointWidth(codePoint);
+
+        if (usedColumns + w > columns && i > start) {
+            break;
         }
 
-        c->updateChildrenDimensionsOnChange();
+        usedColumns += w;
+        i += len;
     }
-}
 
-void GridNode::onChildRemoved(size_t idx, NodePtr removedChild) {
-    throw logic_error("unimplemented");
+    return i - start;
 }
 
-bool LeafNode::canHaveChildren() const noexcept { return false; }
+/**
+ *
+ * Makes the node's slot in the `LayoutStore` lay out `text`.
+ * Its display width is kept as the `textSize`, so the text isn't
+ * scanned again until it changes.
+ */
+static void initializeText(NodeHandle handle, const string& text,
+                           TextLines* lines) {
+    LayoutStore& store = getLayoutStore();
 
-NodeTypes LeafNode::nodeType() const noexcept { return NodeTypes::LEAF; }
+    store.kind[handle] = TEXT_LAYOUT;
+    store.flags[handle] |= INLINE_STYLE;
+    store.textSize[handle] = static_cast<unsigned int>(displayWidth(text));
+    store.width[handle] = store.textSize[handle];
+    store.textLines[handle] = lines;
+}
 
 TextNode::TextNode(string text) : text(text) {
+    initializeText(getHandle(), this->text, &lines);
     setPosX(0);
     setPosY(0);
-    setWidth(static_cast<unsigned int>(text.size()));
     setHeight(1);
 }
 
 TextNode::TextNode(string text, unsigned int posX) : text(text) {
+    initializeText(getHandle(), this->text, &lines);
     setPosX(posX);
     setPosY(0);
-    setWidth(static_cast<unsigned int>(text.size()));
     setHeight(1);
 }
 
 TextNode::TextNode(string text, unsigned int posX, unsigned int posY)
     : text(text) {
+    initializeText(getHandle(), this->text, &lines);
     setPosX(posX);
     setPosY(posY);
-    setWidth(static_cast<unsigned int>(text.size()));
     setHeight(1);
 }
 
 TextNode::TextNode(string text, unsigned int posX, unsigned int posY,
                    unsigned int width)
     : text(text) {
+    initializeText(getHandle(), this->text, &lines);
     setPosX(posX);
     setPosY(posY);
     setWidth(width);
@@ -515,67 +652,36 @@ TextNode::TextNode(string text, unsigned int posX, unsigned int posY,
 TextNode::TextNode(string text, unsigned int posX, unsigned int posY,
                    unsigned int width, unsigned int height)
     : text(text) {
+    initializeText(getHandle(), this->text, &lines);
     setPosX(posX);
     setPosY(posY);
     setWidth(width);
     setHeight(height);
 }
 
-NodeRenderStyle TextNode::nodeRenderStyle() const noexcept {
-    return NodeRenderStyle::INLINE;
-}
-
 void TextNode::render(ostringstream* buf) const {
     moveCursorTo(buf, getPosX(), getPosY());
 
-    if (color != nullopt) {
-        textForeground(buf, get<0>(color.value()), get<1>(color.value()),
-                       get<2>(color.value()));
-    }
-
-    if (backgroundColor != nullopt) {
-        textBackground(buf, get<0>(backgroundColor.value()),
-                       get<1>(backgroundColor.value()),
-                       get<2>(backgroundColor.value()));
-    }
-
-    for (const auto& format : formats) {
-        switch (format) {
-            case TextNodeFormats::BOLD:
-                textBold(buf);
-                break;
-            case TextNodeFormats::STRIKETHROUGH:
-                textStrikethrough(buf);
-                break;
-            case TextNodeFormats::DIM:
-                textDim(buf);
-                break;
-            case TextNodeFormats::ITALIC:
-                textItalic(buf);
-                break;
-            case TextNodeFormats::UNDERLINE:
-                textUnderline(buf);
-                break;
-        }
-    }
-
-    size_t len = text.size();
-    size_t currWidth = static_cast<size_t>(getWidth());
-    size_t currHeight = static_cast<size_t>(getHeight());
+    // one sequence for all of the style, built when it was interned
+    const string& sgr = getTextStyleTable().getSgr(styleId);
 
-    if (len > currWidth) {
-        size_t currLine = 0;
+    *buf << sgr;
 
-        while (currLine < currHeight) {
-            size_t start = currWidth * currLine;
+    unsigned int textWidth = getLayoutStore().textSize[getHandle()];
+    unsigned int currWidth = getWidth();
+    size_t currHeight = static_cast<size_t>(getHeight());
 
-            if (start >= len) {
-                break;
-            }
+    if (textWidth > currWidth) {
+        // the lines are only wrapped again when the text or the
+        // width changed, and are written out without copying them
+        string_view view(text);
+        const vector<TextLine>& textLines = lines.wrap(currWidth);
+        size_t lineCount = min(textLines.size(), currHeight);
 
-            string str = text.substr(start, currWidth);
+        for (size_t currLine = 0; currLine < lineCount;) {
+            const TextLine& line = textLines[currLine];
 
-            *buf << str;
+            *buf << view.substr(line.begin, line.end - line.begin);
 
             moveCursorTo(buf, getPosX(),
                          getPosY() + static_cast<unsigned int>(++currLine));
@@ -608,135 +714,243 @@ void TextNode::render(ostringstream* buf) const {
         }*/
     }
 
-    textReset(buf);
+    if (!sgr.empty()) {
+        textReset(buf);
+    }
 }
 
 void TextNode::setWidth(unsigned int w) {
     assert(w > 0 || !"TextNode::setWidth() received a width that's not > 0");
 
-    unsigned int textSize = static_cast<unsigned int>(text.size());
+    Node::setWidth(w);
+}
+
+void TextNode::setHeight(unsigned int h) {
+    assert(h > 0 || !"TextNode::setHeight() received a height that's not > 0");
 
-    if (w < textSize) {
-        height = static_cast<unsigned int>(
-            ceil(static_cast<float>(textSize) / static_cast<float>(w)));
+    Node::setHeight(h);
+}
 
-        if (height == 0) {
-            height = 1;
-        }
+void TextNode::patchFrom(const Node& node) {
+    const TextNode& textNode = static_cast<const TextNode&>(node);
+
+    Node::patchFrom(node);
+    setText(textNode.text);
+
+    if (styleId != textNode.styleId) {
+        styleId = textNode.styleId;
+
+        markPaintDirty();
     }
+}
 
-    width = w;
+void TextNode::recycle() noexcept {
+    Node::recycle();
+    text.clear();
+    lines.invalidate();
+    styleId = PLAIN_TEXT_STYLE;
 }
 
-void TextNode::setHeight(unsigned int h) {
-    assert(h > 0 || !"TextNode::setHeight() received a height that's not > 0");
+void TextNode::reuse(string_view t, unsigned int posX, unsigned int posY,
+                     unsigned int width, unsigned int height) {
+    Node::reuse();
+    // assigned, so a text that fits the last one's capacity
+    // isn't allocated
+    text.assign(t.data(), t.size());
+    initializeText(getHandle(), text, &lines);
+    setPosX(posX);
+    setPosY(posY);
+
+    if (width > 0) {
+        setWidth(width);
+    }
+
+    setHeight(height);
+}
 
-    size_t textSize = text.size();
+string TextNode::getText() const noexcept { return text; }
 
-    if (width < textSize) {
-        assert(h < static_cast<unsigned int>(ceil(static_cast<float>(textSize) / static_cast<float>(width))) || !"TextNode::setHeight() received insufficient height to accommodate the wrapping of its text contents.");
+void TextNode::setText(string t) {
+    if (t == text) {
+        return;
     }
 
-    height = h;
+    text = move(t);
+    lines.invalidate();
+    getLayoutStore().textSize[getHandle()] =
+        static_cast<unsigned int>(displayWidth(text));
+
+    markLayoutDirty();
+    markPaintDirty();
 }
 
-void TextNode::setRedColor(uint8_t r) {
-    if (color == nullopt) {
-        color = {r, 0, 0};
-    } else {
-        get<0>(color.value()) = r;
+TextStyle TextNode::getStyle() const noexcept {
+    return getTextStyleTable().getStyle(styleId);
+}
+
+void TextNode::setStyle(TextStyle style) {
+    TextStyleId id = getTextStyleTable().intern(style);
+
+    if (id == styleId) {
+        return;
     }
+
+    styleId = id;
+    markPaintDirty();
+}
+
+void TextNode::setRedColor(uint8_t r) {
+    TextStyle style = getStyle();
+    auto [_, g, b] = style.getColor();
+
+    style.setColor(r, g, b);
+    setStyle(style);
 }
 
 void TextNode::setGreenColor(uint8_t g) {
-    if (color == nullopt) {
-        color = {0, g, 0};
-    } else {
-        get<1>(color.value()) = g;
-    }
+    TextStyle style = getStyle();
+    auto [r, _, b] = style.getColor();
+
+    style.setColor(r, g, b);
+    setStyle(style);
 }
 
 void TextNode::setBlueColor(uint8_t b) {
-    if (color == nullopt) {
-        color = {0, 0, b};
-    } else {
-        get<2>(color.value()) = b;
-    }
+    TextStyle style = getStyle();
+    auto [r, g, _] = style.getColor();
+
+    style.setColor(r, g, b);
+    setStyle(style);
 }
 
 void TextNode::setColor(uint8_t r, uint8_t g, uint8_t b) {
-    if (color == nullopt) {
-        color = {r, g, b};
-    } else {
-        get<0>(color.value()) = r;
-        get<1>(color.value()) = g;
-        get<2>(color.value()) = b;
-    }
+    TextStyle style = getStyle();
+
+    style.setColor(r, g, b);
+    setStyle(style);
 }
 
-void TextNode::resetColor() noexcept { color.reset(); }
+void TextNode::resetColor() {
+    TextStyle style = getStyle();
+
+    style.resetColor();
+    setStyle(style);
+}
 
 void TextNode::setRedBackgroundColor(uint8_t r) {
-    if (backgroundColor == nullopt) {
-        backgroundColor = {r, 0, 0};
-    } else {
-        get<0>(backgroundColor.value()) = r;
-    }
+    TextStyle style = getStyle();
+    auto [_, g, b] = style.getBackgroundColor();
+
+    style.setBackgroundColor(r, g, b);
+    setStyle(style);
 }
 
 void TextNode::setGreenBackgroundColor(uint8_t g) {
-    if (backgroundColor == nullopt) {
-        backgroundColor = {0, g, 0};
-    } else {
-        get<1>(backgroundColor.value()) = g;
-    }
+    TextStyle style = getStyle();
+    auto [r, _, b] = style.getBackgroundColor();
+
+    style.setBackgroundColor(r, g, b);
+    setStyle(style);
 }
 
 void TextNode::setBlueBackgroundColor(uint8_t b) {
-    if (backgroundColor == nullopt) {
-        backgroundColor = {0, 0, b};
-    } else {
-        get<2>(backgroundColor.value()) = b;
-    }
+    TextStyle style = getStyle();
+    auto [r, g, _] = style.getBackgroundColor();
+
+    style.setBackgroundColor(r, g, b);
+    setStyle(style);
 }
 
 void TextNode::setBackgroundColor(uint8_t r, uint8_t g, uint8_t b) {
-    if (backgroundColor == nullopt) {
-        backgroundColor = {r, g, b};
-    } else {
-        get<0>(backgroundColor.value()) = r;
-        get<1>(backgroundColor.value()) = g;
-        get<2>(backgroundColor.value()) = b;
-    }
+    TextStyle style = getStyle();
+
+    style.setBackgroundColor(r, g, b);
+    setStyle(style);
+}
+
+void TextNode::resetBackgroundColor() {
+    TextStyle style = getStyle();
+
+    style.resetBackgroundColor();
+    setStyle(style);
 }
 
-void TextNode::resetBackgroundColor() noexcept { backgroundColor.reset(); }
+void TextNode::setBold() {
+    TextStyle style = getStyle();
 
-void TextNode::setBold() { formats.insert(TextNodeFormats::BOLD); }
+    style.addFormat(TextNodeFormats::BOLD);
+    setStyle(style);
+}
+
+void TextNode::removeBold() {
+    TextStyle style = getStyle();
+
+    style.removeFormat(TextNodeFormats::BOLD);
+    setStyle(style);
+}
 
-void TextNode::removeBold() { formats.erase(TextNodeFormats::BOLD); }
+void TextNode::setItalic() {
+    TextStyle style = getStyle();
 
-void TextNode::setItalic() { formats.insert(TextNodeFormats::ITALIC); }
+    style.addFormat(TextNodeFormats::ITALIC);
+    setStyle(style);
+}
+
+void TextNode::removeItalic() {
+    TextStyle style = getStyle();
 
-void TextNode::removeItalic() { formats.erase(TextNodeFormats::ITALIC); }
+    style.removeFormat(TextNodeFormats::ITALIC);
+    setStyle(style);
+}
 
 void TextNode::setStrikethrough() {
-    formats.insert(TextNodeFormats::STRIKETHROUGH);
+    TextStyle style = getStyle();
+
+    style.addFormat(TextNodeFormats::STRIKETHROUGH);
+    setStyle(style);
 }
 
 void TextNode::removeStrikethrough() {
-    formats.erase(TextNodeFormats::STRIKETHROUGH);
+    TextStyle style = getStyle();
+
+    style.removeFormat(TextNodeFormats::STRIKETHROUGH);
+    setStyle(style);
+}
+
+void TextNode::setDim() {
+    TextStyle style = getStyle();
+
+    style.addFormat(TextNodeFormats::DIM);
+    setStyle(style);
 }
 
-void TextNode::setDim() { formats.insert(TextNodeFormats::DIM); }
+void TextNode::removeDim() {
+    TextStyle style = getStyle();
+
+    style.removeFormat(TextNodeFormats::DIM);
+    setStyle(style);
+}
+
+void TextNode::setUnderline() {
+    TextStyle style = getStyle();
+
+    style.addFormat(TextNodeFormats::UNDERLINE);
+    setStyle(style);
+}
 
-void TextNode::removeDim() { formats.erase(TextNodeFormats::DIM); }
+void TextNode::removeUnderline() {
+    TextStyle style = getStyle();
 
-void TextNode::setUnderline() { formats.insert(TextNodeFormats::UNDERLINE); }
+    style.removeFormat(TextNodeFormats::UNDERLINE);
+    setStyle(style);
+}
 
-void TextNode::removeUnderline() { formats.erase(TextNodeFormats::UNDERLINE); }
+void TextNode::resetFormatting() {
+    TextStyle style = getStyle();
 
-void TextNode::resetFormatting() { formats.clear(); }
+    style.resetFormats();
+    setStyle(style);
+}
 
 LineBreakNode::LineBreakNode() { setHeight(1); }
 
@@ -761,38 +975,84 @@ LineBreakNode::LineBreakNode(unsigned int height, unsigned int posX,
 
 void LineBreakNode::render(ostringstream* buf) const {}
 
-SelectOptionNode::SelectOptionNode(string value)
-    : TextNode(kebabToPascal(value)), value(value) {}
-
-SelectOptionNode::SelectOptionNode(string value, unsigned int posX)
-    : TextNode(kebabToPascal(value), posX), value(value) {}
+void LineBreakNode::reuse(unsigned int height, unsigned int posX,
+                          unsigned int posY) {
+    assert(height > 0 || !"LineBreakNode() height must be > 0");
 
-SelectOptionNode::SelectOptionNode(string value, unsigned int posX,
+    Node::reuse();
+    setHeight(height);
+    setPosX(posX);
+    setPosY(posY);
+}
+
+SelectOptionNode::SelectOptionNode(string value)
+    : TextNode(kebabToPascal(value)), value(value) {
+    setKey(value);
+    setNodeRenderStyle(NodeRenderStyle::BLOCK);
+}
+
+SelectOptionNode::SelectOptionNode(string value, unsigned int posX)
+    : TextNode(kebabToPascal(value), posX), value(value) {
+    setKey(value);
+    setNodeRenderStyle(NodeRenderStyle::BLOCK);
+}
+
+SelectOptionNode::SelectOptionNode(string value, unsigned int posX,
                                    unsigned int posY)
-    : TextNode(kebabToPascal(value), posX, posY), value(value) {}
+    : TextNode(kebabToPascal(value), posX, posY), value(value) {
+    setKey(value);
+    setNodeRenderStyle(NodeRenderStyle::BLOCK);
+}
 
 SelectOptionNode::SelectOptionNode(string value, unsigned int posX,
                                    unsigned int posY, unsigned int width)
-    : TextNode(kebabToPascal(value), posX, posY, width), value(value) {}
+    : TextNode(kebabToPascal(value), posX, posY, width), value(value) {
+    setKey(value);
+    setNodeRenderStyle(NodeRenderStyle::BLOCK);
+}
 
 SelectOptionNode::SelectOptionNode(string value, unsigned int posX,
                                    unsigned int posY, unsigned int width,
                                    unsigned int height)
-    : TextNode(kebabToPascal(value), posX, posY, width, height), value(value) {}
+    : TextNode(kebabToPascal(value), posX, posY, width, height),
+      value(value) {
+    setKey(value);
+    setNodeRenderStyle(NodeRenderStyle::BLOCK);
+}
+
+void SelectOptionNode::patchFrom(const Node& node) {
+    const SelectOptionNode& option = static_cast<const SelectOptionNode&>(node);
+
+    // the colors are set by the SelectNode when it renders, so
+    // only the text is compared
+    Node::patchFrom(node);
+    setText(option.getText());
+    value = option.value;
+}
 
-NodeRenderStyle SelectOptionNode::nodeRenderStyle() const noexcept {
-    return NodeRenderStyle::BLOCK;
+void SelectOptionNode::reuse(string_view v, unsigned int posX,
+                             unsigned int posY, unsigned int width,
+                             unsigned int height) {
+    TextNode::reuse(string_view(), posX, posY, width, height);
+    value.assign(v.data(), v.size());
+    appendKebabToPascal(text, value, true);
+    initializeText(getHandle(), text, &lines);
+    setKey(value);
+    setNodeRenderStyle(NodeRenderStyle::BLOCK);
 }
 
 string SelectOptionNode::getValue() const noexcept { return value; }
 
 void InteractableNode::render(ostringstream* buf) const {
-    for (NodePtr node : children) {
+    for (NodePtr node = getFirstChild(); node != nullptr;
+         node = node->getNextSibling()) {
         node->render(buf);
     }
 }
 
-bool InteractableNode::onKeyPressed(unsigned int keyCode) { return false; }
+bool InteractableNode::onKeyPressed(unsigned int) { return false; }
+
+void InteractableNode::bindKeys(KeyBindingTable&, FocusScopeId) {}
 
 NodeTypes InteractableNode::nodeType() const noexcept {
     return NodeTypes::INTERACTABLE;
@@ -801,123 +1061,126 @@ NodeTypes InteractableNode::nodeType() const noexcept {
 SelectNode::SelectNode() : activeOptionIdx(0) {}
 SelectNode::SelectNode(size_t activeOptionIdx)
     : activeOptionIdx(activeOptionIdx) {}
-SelectNode::~SelectNode() { subscribers.clear(); }
+SelectNode::~SelectNode() { subscribers.disconnectAll(); }
+
+static void styleOption(SelectOptionNode* option, bool isActive) {
+    if (isActive) {
+        option->setColor(0, 0, 0);
+        option->setBackgroundColor(255, 255, 255);
+    } else {
+        option->resetColor();
+        option->resetBackgroundColor();
+    }
+}
 
 void SelectNode::selectNext() noexcept {
-    activeOptionIdx = (activeOptionIdx + 1) % children.size();
+    activeOptionIdx = (activeOptionIdx + 1) % getChildCount();
 
+    styleOptions();
+    markPaintDirty();
     notify();
 }
 
 void SelectNode::selectPrevious() noexcept {
     if (activeOptionIdx == 0) {
-        activeOptionIdx = children.size() - 1;
+        activeOptionIdx = getChildCount() - 1;
     } else {
         activeOptionIdx -= 1;
     }
 
+    styleOptions();
+    markPaintDirty();
     notify();
 }
 
-void SelectNode::notify() {
-    optional<string> activeValId = getValueOfSelectedOption();
+void SelectNode::styleOptions() noexcept {
+    size_t i = 0;
 
-    for (SubscriberCallback subscriber : subscribers) {
-        subscriber(activeValId);
+    for (NodePtr child = getFirstChild(); child != nullptr;
+         child = child->getNextSibling(), ++i) {
+        styleOption(static_cast<SelectOptionNode*>(child),
+                    i == activeOptionIdx);
     }
 }
 
-void SelectNode::render(ostringstream* buf) const {
-    for (size_t i = 0, l = children.size(); i < l; ++i) {
-        shared_ptr<SelectOptionNode> node =
-            static_pointer_cast<SelectOptionNode>(children.at(i));
-
-        if (i == activeOptionIdx) {
-            node->setColor(0, 0, 0);
-            node->setBackgroundColor(255, 255, 255);
-        } else {
-            node->resetColor();
-            node->resetBackgroundColor();
-        }
-
-        node->render(buf);
-    }
-}
+void SelectNode::notify() {
+    optional<string> activeValId = getValueOfSelectedOption();
 
-void SelectNode::subscribe(SelectNode::SubscriberCallback cb) {
-    subscribers.push_back(cb);
+    subscribers.emit(activeValId);
 }
 
-void SelectNode::unsubscribe(SelectNode::SubscriberCallback cb) {
-    subscribers.erase(
-        remove_if(subscribers.begin(), subscribers.end(),
-                  [&cb](const SelectNode::SubscriberCallback currCb) {
-                      return currCb.target_type() == cb.target_type();
-                  }),
-        subscribers.end());
+void SelectNode::render(ostringstream* buf) const {
+    for (NodePtr child = getFirstChild(); child != nullptr;
+         child = child->getNextSibling()) {
+        child->render(buf);
+    }
 }
 
-void SelectNode::onChildRemoved(size_t idx, NodePtr removedChild) {
-    if (children.empty()) {
-        setWidth(0);
-        setHeight(0);
+void SelectNode::patchFrom(const Node& node) {
+    const SelectNode& select = static_cast<const SelectNode&>(node);
 
-        activeOptionIdx = 0;
+    Node::patchFrom(node);
 
-        return;
-    }
+    if (activeOptionIdx != select.activeOptionIdx) {
+        activeOptionIdx = select.activeOptionIdx;
 
-    unsigned int heightOfRemovedChild = removedChild->getHeight();
-    unsigned int largestWidth = 0;
-
-    for (NodePtr node : children) {
-        unsigned nodeRealWidth = node->getPosX() + node->getWidth();
-
-        if (largestWidth < nodeRealWidth) {
-            largestWidth = nodeRealWidth;
-        }
+        markPaintDirty();
     }
 
-    for (size_t i = idx, l = children.size(); i < l; ++i) {
-        NodePtr node = children.at(i);
+    styleOptions();
 
-        node->setPosX(node->getPosX() - heightOfRemovedChild);
-    }
+    subscribers = select.subscribers;
+}
 
-    setWidth(largestWidth);
-    setHeight(getHeight() - heightOfRemovedChild);
+Connection SelectNode::subscribe(SelectNode::SubscriberCallback cb) {
+    return subscribers.connect(cb);
+}
 
-    // ==== Update option if active is removed  ==== //
+void SelectNode::unsubscribe(Connection connection) noexcept {
+    subscribers.disconnect(connection);
+}
 
-    size_t childrenSize = children.size();
+void SelectNode::onChildRemoved(size_t idx, NodePtr) {
+    size_t childrenSize = getChildCount();
 
-    if (activeOptionIdx == childrenSize) {
+    if (childrenSize == 0) {
+        activeOptionIdx = 0;
+    } else if (activeOptionIdx == childrenSize) {
         activeOptionIdx = childrenSize - 1;
     } else if (idx < activeOptionIdx) {
         activeOptionIdx -= 1;
     }
+
+    styleOptions();
 }
 
 void SelectNode::assertChildIsValid(NodePtr child) const {
-    assert(dynamic_pointer_cast<SelectOptionNode>(child) ||
+    assert(dynamic_cast<SelectOptionNode*>(child) ||
            !"SelectNode only accepts SelectOptionNode as its children");
 }
 
+void SelectNode::appendChild(NodePtr child) {
+    Node::appendChild(child);
+    styleOption(static_cast<SelectOptionNode*>(child),
+                getChildCount() - 1 == activeOptionIdx);
+}
+
 void SelectNode::resetActiveIdx() noexcept {
     activeOptionIdx = 0;
+    styleOptions();
+    markPaintDirty();
     notify();
 }
 
 optional<string> SelectNode::getValueOfSelectedOption() const {
-    if (children.empty()) {
+    if (getChildCount() == 0) {
         return nullopt;
     }
 
-    assert(activeOptionIdx < children.size() || !"SelectNode::getValueOfSelectedOption() is called when activeOptionIdx is < children.size()");
+    assert(activeOptionIdx < getChildCount() || !"SelectNode::getValueOfSelectedOption() is called when activeOptionIdx is < children.size()");
 
-    const shared_ptr<const SelectOptionNode> selectedOptionNode =
-        static_pointer_cast<const SelectOptionNode>(
-            children.at(activeOptionIdx));
+    const SelectOptionNode* selectedOptionNode =
+        static_cast<const SelectOptionNode*>(getChildAt(activeOptionIdx));
 
     return selectedOptionNode->getValue();
 }
@@ -928,15 +1191,20 @@ size_t SelectNode::getActiveOptionIdx() const noexcept {
 
 void SelectNode::setActiveChildWithValue(string val) {
     assert(
-        !children.empty() ||
+        getChildCount() > 0 ||
         !"SelectNode::setActiveChildWithValue() is called with no children.");
 
-    for (size_t i = 0, l = children.size(); i < l; ++i) {
-        const shared_ptr<const SelectOptionNode> child =
-            static_pointer_cast<SelectOptionNode>(children.at(i));
+    size_t i = 0;
+
+    for (NodePtr node = getFirstChild(); node != nullptr;
+         node = node->getNextSibling(), ++i) {
+        const SelectOptionNode* child =
+            static_cast<const SelectOptionNode*>(node);
 
         if (child->getValue() == val) {
             activeOptionIdx = i;
+            styleOptions();
+            markPaintDirty();
             notify();
             return;
         }
@@ -960,52 +1228,486 @@ bool SelectNode::onKeyPressed(unsigned int keyCode) {
             return false;
     }
 }
+
+void SelectNode::bindKeys(KeyBindingTable& table, FocusScopeId scope) {
+    table.bind(KEY_UP, this, scope);
+    table.bind(KEY_DOWN, this, scope);
+}
+
+VirtualListNode::VirtualListNode(size_t rowCount, RowSource rowSource)
+    : VirtualListNode(rowCount, rowSource, getScreen().getHeight()) {}
+
+VirtualListNode::VirtualListNode(size_t rowCount, RowSource rowSource,
+                                 unsigned int visibleRowCount)
+    : rowCount(rowCount),
+      rowSource(rowSource),
+      activeRowIdx(0),
+      firstVisibleRowIdx(0),
+      visibleRowCount(visibleRowCount) {
+    assert(visibleRowCount > 0 ||
+           !"VirtualListNode needs room for at least one row");
+
+    setLayoutKind(LIST_LAYOUT);
+    fetchVisibleRows();
+}
+
+VirtualListNode::~VirtualListNode() { subscribers.disconnectAll(); }
+
+void VirtualListNode::selectNext() noexcept {
+    if (rowCount == 0) {
+        return;
+    }
+
+    activeRowIdx = (activeRowIdx + 1) % rowCount;
+
+    if (scrollToActiveRow()) {
+        fetchVisibleRows();
+    }
+
+    markPaintDirty();
+    notify();
+}
+
+void VirtualListNode::selectPrevious() noexcept {
+    if (rowCount == 0) {
+        return;
+    }
+
+    if (activeRowIdx == 0) {
+        activeRowIdx = rowCount - 1;
+    } else {
+        activeRowIdx -= 1;
+    }
+
+    if (scrollToActiveRow()) {
+        fetchVisibleRows();
+    }
+
+    markPaintDirty();
+    notify();
+}
+
+bool VirtualListNode::scrollToActiveRow() noexcept {
+    size_t firstRowIdx = firstVisibleRowIdx;
+
+    if (activeRowIdx < firstRowIdx) {
+        firstRowIdx = activeRowIdx;
+    } else if (activeRowIdx >= firstRowIdx + visibleRowCount) {
+        firstRowIdx = activeRowIdx - visibleRowCount + 1;
+    }
+
+    // don't leave rows empty at the bottom once the list got
+    // shorter or the window taller
+    firstRowIdx = min(
+        firstRowIdx, rowCount > visibleRowCount ? rowCount - visibleRowCount
+                                                : static_cast<size_t>(0));
+
+    if (firstRowIdx == firstVisibleRowIdx) {
+        return false;
+    }
+
+    firstVisibleRowIdx = firstRowIdx;
+
+    return true;
+}
+
+void VirtualListNode::fetchVisibleRows() {
+    LayoutStore& store = getLayoutStore();
+    NodeHandle handle = getHandle();
+    size_t endRowIdx = min(rowCount, firstVisibleRowIdx + visibleRowCount);
+
+    visibleRows.clear();
+
+    for (size_t i = firstVisibleRowIdx; i < endRowIdx; ++i) {
+        visibleRows.push_back(rowSource(i));
+    }
+
+    // stays as wide as the widest row shown so far, so it doesn't
+    // change width back and forth while scrolling
+    unsigned int widest = store.textSize[handle];
+    unsigned int rows = static_cast<unsigned int>(visibleRows.size());
+
+    for (const string& row : visibleRows) {
+        widest = max(widest, static_cast<unsigned int>(displayWidth(row)));
+    }
+
+    if (widest != store.textSize[handle] ||
+        rows != store.preferredHeight[handle]) {
+        store.textSize[handle] = widest;
+        store.preferredHeight[handle] = rows;
+
+        markLayoutDirty();
+    }
+}
+
+void VirtualListNode::notify() {
+    subscribers.emit(activeRowIdx);
+}
+
+void VirtualListNode::render(ostringstream* buf) const {
+    for (size_t i = 0; i < visibleRows.size(); ++i) {
+        moveCursorTo(buf, getPosX(),
+                     getPosY() + static_cast<unsigned int>(i));
+
+        if (firstVisibleRowIdx + i == activeRowIdx) {
+            textForeground(buf, 0, 0, 0);
+            textBackground(buf, 255, 255, 255);
+        }
+
+        *buf << visibleRows[i].substr(
+            0, bytesInColumns(visibleRows[i], 0, getWidth()));
+
+        textReset(buf);
+    }
+}
+
+void VirtualListNode::patchFrom(const Node& node) {
+    const VirtualListNode& list = static_cast<const VirtualListNode&>(node);
+    bool isMoved = rowCount != list.rowCount ||
+                   activeRowIdx != list.activeRowIdx ||
+                   visibleRowCount != list.visibleRowCount;
+
+    Node::patchFrom(node);
+
+    rowCount = list.rowCount;
+    rowSource = list.rowSource;
+    activeRowIdx = list.activeRowIdx;
+    visibleRowCount = list.visibleRowCount;
+    subscribers = list.subscribers;
+
+    // sources can't be compared, so the rows in the window are
+    // pulled again and compared instead. The window itself stays
+    // where it was scrolled to unless the active row left it.
+    vector<string> prevRows = move(visibleRows);
+
+    isMoved = scrollToActiveRow() || isMoved;
+    fetchVisibleRows();
+
+    if (isMoved || visibleRows != prevRows) {
+        markPaintDirty();
+    }
+}
+
+Connection VirtualListNode::subscribe(SubscriberCallback cb) {
+    return subscribers.connect(cb);
+}
+
+void VirtualListNode::unsubscribe(Connection connection) noexcept {
+    subscribers.disconnect(connection);
+}
+
+bool VirtualListNode::onKeyPressed(unsigned int keyCode) {
+    switch (keyCode) {
+        case KEY_DOWN: {
+            selectNext();
+        };
+            return true;
+        case KEY_UP: {
+            selectPrevious();
+        };
+            return true;
+        default:
+            return false;
+    }
+}
+
+void VirtualListNode::bindKeys(KeyBindingTable& table, FocusScopeId scope) {
+    table.bind(KEY_UP, this, scope);
+    table.bind(KEY_DOWN, this, scope);
+}
+
+bool VirtualListNode::canHaveChildren() const noexcept { return false; }
+
+size_t VirtualListNode::getRowCount() const noexcept { return rowCount; }
+
+size_t VirtualListNode::getActiveRowIdx() const noexcept {
+    return activeRowIdx;
+}
+
+void VirtualListNode::setActiveRowIdx(size_t idx) {
+    assert(idx < rowCount ||
+           !"Passed in a size_t idx >= getRowCount() at "
+           "VirtualListNode::setActiveRowIdx().");
+
+    activeRowIdx = idx;
+
+    if (scrollToActiveRow()) {
+        fetchVisibleRows();
+    }
+
+    markPaintDirty();
+}
+
+size_t VirtualListNode::getFirstVisibleRowIdx() const noexcept {
+    return firstVisibleRowIdx;
+}
+
+unsigned int VirtualListNode::getVisibleRowCount() const noexcept {
+    return visibleRowCount;
+}
+
+void VirtualListNode::setVisibleRowCount(unsigned int count) {
+    assert(count > 0 || !"VirtualListNode needs room for at least one row");
+
+    visibleRowCount = count;
+
+    scrollToActiveRow();
+    fetchVisibleRows();
+    markPaintDirty();
+}
+
+TableNode::TableNode(vector<string> header)
+    : TableNode(move(header), getScreen().getHeight()) {}
+
+TableNode::TableNode(vector<string> header, unsigned int visibleRowCount)
+    : columnAligns(header.size(), TableColumnAlign::LEFT_ALIGN),
+      colGap(2),
+      firstVisibleRowIdx(0),
+      visibleRowCount(visibleRowCount) {
+    assert(!header.empty() || !"TableNode needs at least one column");
+    assert(visibleRowCount > 0 ||
+           !"TableNode needs room for at least one row");
+
+    setLayoutKind(LIST_LAYOUT);
+
+    for (string& title : header) {
+        unsigned int w = static_cast<unsigned int>(displayWidth(title));
+
+        columnWidths.push_back(w);
+        cellWidths.push_back(w);
+        cells.push_back(move(title));
+    }
+
+    fitContent();
+}
+
+void TableNode::fitContent() noexcept {
+    LayoutStore& store = getLayoutStore();
+    NodeHandle handle = getHandle();
+    unsigned int w = colGap * static_cast<unsigned int>(getColumnCount() - 1);
+
+    for (unsigned int columnWidth : columnWidths) {
+        w += columnWidth;
+    }
+
+    // the header row stays on top of the window
+    unsigned int h =
+        1 + static_cast<unsigned int>(
+                min(getRowCount(), static_cast<size_t>(visibleRowCount)));
+
+    if (w != store.textSize[handle] || h != store.preferredHeight[handle]) {
+        store.textSize[handle] = w;
+        store.preferredHeight[handle] = h;
+
+        markLayoutDirty();
+    }
+}
+
+void TableNode::clampScroll() noexcept {
+    size_t rowCount = getRowCount();
+
+    if (rowCount <= visibleRowCount) {
+        firstVisibleRowIdx = 0;
+    } else {
+        firstVisibleRowIdx =
+            min(firstVisibleRowIdx, rowCount - visibleRowCount);
+    }
+}
+
+void TableNode::renderRow(ostringstream* buf, size_t row,
+                          unsigned int line) const {
+    size_t columnCount = getColumnCount();
+    unsigned int maxWidth = getWidth();
+    unsigned int currX = 0;
+
+    moveCursorTo(buf, getPosX(), getPosY() + line);
+
+    for (size_t col = 0; col < columnCount; ++col) {
+        size_t idx = row * columnCount + col;
+        unsigned int gap = col == 0 ? 0 : colGap;
+        unsigned int padding = columnWidths.at(col) - cellWidths.at(idx);
+
+        // columns that don't fit are left out instead of being
+        // cut in the middle of a character
+        if (currX + gap + columnWidths.at(col) > maxWidth) {
+            break;
+        }
+
+        *buf << string(gap, ' ');
+
+        if (columnAligns.at(col) == TableColumnAlign::RIGHT_ALIGN) {
+            *buf << string(padding, ' ') << cells.at(idx);
+        } else if (col + 1 < columnCount) {
+            *buf << cells.at(idx) << string(padding, ' ');
+        } else {
+            *buf << cells.at(idx);
+        }
+
+        currX += gap + columnWidths.at(col);
+    }
+}
+
+void TableNode::render(ostringstream* buf) const {
+    size_t endRowIdx = min(getRowCount(), firstVisibleRowIdx + visibleRowCount);
+    unsigned int line = 1;
+
+    textBold(buf);
+    renderRow(buf, 0, 0);
+    textReset(buf);
+
+    for (size_t i = firstVisibleRowIdx; i < endRowIdx; ++i, ++line) {
+        renderRow(buf, i + 1, line);
+    }
+}
+
+void TableNode::patchFrom(const Node& node) {
+    const TableNode& table = static_cast<const TableNode&>(node);
+
+    Node::patchFrom(node);
+
+    if (cells == table.cells && columnAligns == table.columnAligns &&
+        colGap == table.colGap && visibleRowCount == table.visibleRowCount) {
+        return;
+    }
+
+    columnAligns = table.columnAligns;
+    columnWidths = table.columnWidths;
+    colGap = table.colGap;
+    cells = table.cells;
+    cellWidths = table.cellWidths;
+    visibleRowCount = table.visibleRowCount;
+
+    // stays scrolled to where it was, as far as the rows allow
+    clampScroll();
+    fitContent();
+    markPaintDirty();
+}
+
+bool TableNode::onKeyPressed(unsigned int keyCode) {
+    switch (keyCode) {
+        case KEY_DOWN: {
+            if (firstVisibleRowIdx + visibleRowCount < getRowCount()) {
+                ++firstVisibleRowIdx;
+                markPaintDirty();
+            }
+        };
+            return true;
+        case KEY_UP: {
+            if (firstVisibleRowIdx > 0) {
+                --firstVisibleRowIdx;
+                markPaintDirty();
+            }
+        };
+            return true;
+        default:
+            return false;
+    }
+}
+
+void TableNode::bindKeys(KeyBindingTable& table, FocusScopeId scope) {
+    table.bind(KEY_UP, this, scope);
+    table.bind(KEY_DOWN, this, scope);
+}
+
+bool TableNode::canHaveChildren() const noexcept { return false; }
+
+size_t TableNode::getColumnCount() const noexcept {
+    return columnAligns.size();
+}
+
+unsigned int TableNode::getColumnWidth(size_t col) const {
+    return columnWidths.at(col);
+}
+
+void TableNode::setColumnAlign(size_t col, TableColumnAlign align) {
+    columnAligns.at(col) = align;
+
+    markPaintDirty();
+}
+
+unsigned int TableNode::getColGap() const noexcept { return colGap; }
+
+void TableNode::setColGap(unsigned int c) {
+    colGap = c;
+
+    fitContent();
+    markPaintDirty();
+}
+
+size_t TableNode::getRowCount() const noexcept {
+    return cells.size() / getColumnCount() - 1;
+}
+
+void TableNode::appendRow(vector<string> row) {
+    assert(row.size() == getColumnCount() ||
+           !"TableNode::appendRow() received a row with a different number "
+           "of cells than there are columns");
+
+    for (size_t col = 0; col < row.size(); ++col) {
+        unsigned int w = static_cast<unsigned int>(displayWidth(row[col]));
+
+        columnWidths[col] = max(columnWidths[col], w);
+        cellWidths.push_back(w);
+        cells.push_back(move(row[col]));
+    }
+
+    fitContent();
+    markPaintDirty();
+}
+
+size_t TableNode::getFirstVisibleRowIdx() const noexcept {
+    return firstVisibleRowIdx;
+}
+
+unsigned int TableNode::getVisibleRowCount() const noexcept {
+    return visibleRowCount;
+}
+
+void TableNode::setVisibleRowCount(unsigned int count) {
+    assert(count > 0 || !"TableNode needs room for at least one row");
+
+    visibleRowCount = count;
+
+    clampScroll();
+    fitContent();
+    markPaintDirty();
+}
+
 int pos = 26;
 
 ButtonNode::ButtonNode(string icon, string text,
                        tuple<unsigned int, unsigned int> keyCode)
     : icon(icon), text(text), keyCode(keyCode), isPressed(false) {
-    height = 1;
-    setWidth(static_cast<unsigned int>(numOfUtf8Chars(icon)) + 1 +
-             static_cast<unsigned int>(text.size()));
+    setLayoutKind(TEXT_LAYOUT);
+    getLayoutStore().textSize[getHandle()] =
+        static_cast<unsigned int>(displayWidth(text));
+    setHeight(1);
+    setWidth(static_cast<unsigned int>(displayWidth(icon)) + 1 +
+             getLayoutStore().textSize[getHandle()]);
 }
 
 ButtonNode::ButtonNode(string icon, string text,
                        tuple<unsigned int, unsigned int> keyCode,
                        bool isPressed)
     : icon(icon), text(text), keyCode(keyCode), isPressed(isPressed) {
-    height = 1;
-    setWidth(static_cast<unsigned int>(numOfUtf8Chars(icon)) + 1 +
-             static_cast<unsigned int>(text.size()));
+    setLayoutKind(TEXT_LAYOUT);
+    getLayoutStore().textSize[getHandle()] =
+        static_cast<unsigned int>(displayWidth(text));
+    setHeight(1);
+    setWidth(static_cast<unsigned int>(displayWidth(icon)) + 1 +
+             getLayoutStore().textSize[getHandle()]);
 }
 
 void ButtonNode::setWidth(unsigned int w) {
     assert(w > 0 || !"TextNode::setWidth() received a width that's not > 0");
 
-    unsigned int textSize = static_cast<unsigned int>(text.size());
-
-    if (w < textSize) {
-        height = static_cast<unsigned int>(
-            ceil(static_cast<float>(textSize) / static_cast<float>(w)));
-
-        if (height == 0) {
-            height = 1;
-        }
-    }
-
-    width = w;
+    Node::setWidth(w);
 }
 
 void ButtonNode::setHeight(unsigned int h) {
     assert(h > 0 || !"TextNode::setHeight() received a height that's not > 0");
 
-    size_t textSize = text.size();
-
-    if (width < textSize) {
-        assert(h < static_cast<unsigned int>(ceil(static_cast<float>(textSize) / static_cast<float>(width))) || !"TextNode::setHeight() received insufficient height to accommodate the wrapping of its text contents.");
-    }
-
-    height = h;
+    Node::setHeight(h);
 }
 
 void ButtonNode::render(ostringstream* buf) const {
@@ -1025,36 +1727,77 @@ void ButtonNode::render(ostringstream* buf) const {
     textReset(buf);
 }
 
-void ButtonNode::notify(unsigned int keyCode) {
-    for (SubscriberCallback subscriber : subscribers) {
-        subscriber(keyCode);
+void ButtonNode::patchFrom(const Node& node) {
+    const ButtonNode& button = static_cast<const ButtonNode&>(node);
+
+    Node::patchFrom(node);
+
+    if (icon != button.icon || text != button.text) {
+        icon = button.icon;
+        text = button.text;
+        getLayoutStore().textSize[getHandle()] =
+            static_cast<unsigned int>(displayWidth(text));
+
+        markLayoutDirty();
+        markPaintDirty();
     }
+
+    if (isPressed != button.isPressed) {
+        isPressed = button.isPressed;
+
+        markPaintDirty();
+    }
+
+    keyCode = button.keyCode;
+    subscribers = button.subscribers;
 }
 
-void ButtonNode::subscribe(SubscriberCallback cb) { subscribers.push_back(cb); }
+void ButtonNode::recycle() noexcept {
+    Node::recycle();
+    subscribers.clear();
+}
 
-void ButtonNode::unsubscribe(SubscriberCallback cb) {
-    subscribers.erase(
-        remove_if(subscribers.begin(), subscribers.end(),
-                  [&cb](const ButtonNode::SubscriberCallback currCb) {
-                      return currCb.target_type() == cb.target_type();
-                  }),
-        subscribers.end());
+void ButtonNode::reuse(string_view icon, string_view text,
+                       tuple<unsigned int, unsigned int> keyCode,
+                       bool isPressed) {
+    Node::reuse();
+    this->icon.assign(icon.data(), icon.size());
+    this->text.assign(text.data(), text.size());
+    this->keyCode = keyCode;
+    this->isPressed = isPressed;
+    setLayoutKind(TEXT_LAYOUT);
+    getLayoutStore().textSize[getHandle()] =
+        static_cast<unsigned int>(displayWidth(this->text));
+    setHeight(1);
+    setWidth(static_cast<unsigned int>(displayWidth(this->icon)) + 1 +
+             getLayoutStore().textSize[getHandle()]);
+}
+
+void ButtonNode::notify(unsigned int keyCode) {
+    subscribers.emit(keyCode);
+}
+
+Connection ButtonNode::subscribe(SubscriberCallback cb) {
+    return subscribers.connect(cb);
 }
 
 bool ButtonNode::onKeyPressed(unsigned int pressedKeyCode) {
     if (get<0>(keyCode) == pressedKeyCode ||
         get<1>(keyCode) == pressedKeyCode) {
-        isPressed = true;
-
         notify(pressedKeyCode);
 
         return true;
     }
 
-    isPressed = false;
-
     return false;
 }
 
+void ButtonNode::bindKeys(KeyBindingTable& table, FocusScopeId scope) {
+    table.bind(get<0>(keyCode), this, scope);
+
+    if (get<1>(keyCode) != get<0>(keyCode)) {
+        table.bind(get<1>(keyCode), this, scope);
+    }
+}
+
 bool ButtonNode::canHaveChildren() const noexcept { return false; }
\ No newline at end of file
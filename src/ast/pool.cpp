@@ -0,0 +1,11 @@
+#include <ast/pool.hpp>
+
+static unique_ptr<NodePools> nodePools;
+
+NodePools& getNodePools() noexcept { return *nodePools; }
+
+void initializeNodePools() {
+    assert(!nodePools || !"NodePools must only be initialized once");
+
+    nodePools = make_unique<NodePools>();
+}
@@ -0,0 +1,52 @@
+#include <ast/reconciler.hpp>
+
+/**
+ *
+ * Same type and key, so one can be patched into the other
+ */
+static bool isSameNode(const Node* retained, const Node* described) noexcept {
+    return typeid(*retained) == typeid(*described) &&
+           retained->getKey() == described->getKey();
+}
+
+bool haveSameShape(const Node* retained, const Node* described) noexcept {
+    if (!isSameNode(retained, described) ||
+        retained->getChildCount() != described->getChildCount()) {
+        return false;
+    }
+
+    for (const Node *r = retained->getFirstChild(),
+                    *d = described->getFirstChild();
+         r != nullptr; r = r->getNextSibling(), d = d->getNextSibling()) {
+        if (!haveSameShape(r, d)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ *
+ * Assumes both trees have the same shape
+ */
+static void patchTree(Node* retained, const Node* described) {
+    retained->patchFrom(*described);
+
+    const Node* d = described->getFirstChild();
+
+    for (Node* r = retained->getFirstChild(); r != nullptr;
+         r = r->getNextSibling(), d = d->getNextSibling()) {
+        patchTree(r, d);
+    }
+}
+
+bool reconcile(Node* retained, const Node* described) {
+    if (!haveSameShape(retained, described)) {
+        return false;
+    }
+
+    patchTree(retained, described);
+
+    return true;
+}
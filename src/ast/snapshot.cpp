@@ -0,0 +1,107 @@
+#include <ast/snapshot.hpp>
+
+/**
+ *
+ * Reads the number starting at byte `idx` and moves `idx` past
+ * it. Returns false if there is none.
+ */
+static bool readNumber(const string& bytes, size_t& idx,
+                       unsigned int& number) noexcept {
+    size_t begin = idx;
+
+    number = 0;
+
+    for (; idx < bytes.size() && bytes[idx] >= '0' && bytes[idx] <= '9';
+         ++idx) {
+        number = number * 10 + static_cast<unsigned int>(bytes[idx] - '0');
+    }
+
+    return idx > begin;
+}
+
+NodeSnapshot::NodeSnapshot(Node* source)
+    : source(source),
+      posX(source->getPosX()),
+      posY(source->getPosY()),
+      width(source->getWidth()),
+      height(source->getHeight()) {
+    ostringstream buf;
+
+    source->render(&buf);
+    bytes = buf.str();
+
+    // nodes only move the cursor with `moveCursorTo()`, which
+    // writes the row, then the column counted from 1
+    for (size_t begin = bytes.find(ESC); begin != string::npos;
+         begin = bytes.find(ESC, begin + 1)) {
+        size_t idx = begin + ESC.size();
+        unsigned int row;
+        unsigned int col;
+
+        if (readNumber(bytes, idx, row) && idx < bytes.size() &&
+            bytes[idx] == SEP[0] && readNumber(bytes, ++idx, col) &&
+            idx < bytes.size() && bytes[idx] == 'H' && col > posX &&
+            row >= posY) {
+            cursorMoves.push_back({begin, idx + 1, col - 1 - posX, row - posY});
+        }
+    }
+}
+
+Node* NodeSnapshot::getSource() const noexcept { return source; }
+
+unsigned int NodeSnapshot::getWidth() const noexcept { return width; }
+
+unsigned int NodeSnapshot::getHeight() const noexcept { return height; }
+
+void NodeSnapshot::write(ostringstream* buf, unsigned int col,
+                         unsigned int row) const {
+    if (col == posX && row == posY) {
+        *buf << bytes;
+
+        return;
+    }
+
+    string_view view(bytes);
+    size_t written = 0;
+
+    for (const CursorMove& move : cursorMoves) {
+        *buf << view.substr(written, move.begin - written);
+        moveCursorTo(buf, col + move.col, row + move.row);
+        written = move.end;
+    }
+
+    *buf << view.substr(written);
+}
+
+SnapshotNode::SnapshotNode(const NodeSnapshot* snapshot) : snapshot(snapshot) {
+    setWidth(snapshot->getWidth());
+    setHeight(snapshot->getHeight());
+}
+
+void SnapshotNode::render(ostringstream* buf) const {
+    snapshot->write(buf, getPosX(), getPosY());
+}
+
+void SnapshotNode::patchFrom(const Node& node) {
+    const SnapshotNode& snapshotNode = static_cast<const SnapshotNode&>(node);
+
+    Node::patchFrom(node);
+
+    if (snapshot != snapshotNode.snapshot) {
+        snapshot = snapshotNode.snapshot;
+
+        markPaintDirty();
+    }
+}
+
+void SnapshotNode::bindKeys(KeyBindingTable& table, FocusScopeId scope) {
+    Node* source = snapshot->getSource();
+
+    if (source->nodeType() == NodeTypes::INTERACTABLE) {
+        static_cast<InteractableNode*>(source)->bindKeys(table, scope);
+    }
+
+    table.bindTree(source, scope);
+}
+
+bool SnapshotNode::canHaveChildren() const noexcept { return false; }
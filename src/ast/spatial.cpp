@@ -0,0 +1,163 @@
+#include <ast/spatial.hpp>
+
+uint32_t SpatialIndex::nextStamp = 1;
+
+SpatialIndex::SpatialIndex(NodeHandle root)
+    : root(root), entryCount(0), staleEntryCount(0) {}
+
+NodeHandle SpatialIndex::getRoot() const noexcept { return root; }
+
+bool SpatialIndex::isLive(const LayoutStore& store,
+                          const Entry& entry) const noexcept {
+    return store.indexStamp[entry.node] == entry.stamp;
+}
+
+unsigned int SpatialIndex::depthOf(const LayoutStore& store,
+                                   NodeHandle node) const noexcept {
+    unsigned int depth = 0;
+
+    for (; node != root && node != NO_NODE; node = store.parent[node]) {
+        ++depth;
+    }
+
+    return depth;
+}
+
+void SpatialIndex::sweep(const LayoutStore& store) {
+    for (vector<Entry>& band : bands) {
+        band.erase(remove_if(band.begin(), band.end(),
+                             [&](const Entry& entry) {
+                                 return !isLive(store, entry);
+                             }),
+                   band.end());
+    }
+
+    entryCount -= staleEntryCount;
+    staleEntryCount = 0;
+}
+
+void SpatialIndex::file(LayoutStore& store, NodeHandle node) {
+    uint32_t& stamp = store.indexStamp[node];
+
+    store.flags[node] |= SPATIALLY_INDEXED;
+
+    if (store.width[node] == 0 || store.height[node] == 0) {
+        if (stamp != 0) {
+            staleEntryCount += store.indexedBandCount[node];
+            stamp = 0;
+        }
+
+        return;
+    }
+
+    unsigned int firstBand = store.posY[node] / SPATIAL_INDEX_BAND_ROWS;
+    unsigned int lastBand =
+        (store.posY[node] + store.height[node] - 1) / SPATIAL_INDEX_BAND_ROWS;
+    unsigned int bandCount = lastBand - firstBand + 1;
+
+    // where exactly the node is gets checked on every lookup
+    if (stamp != 0 && store.indexedBand[node] == firstBand &&
+        store.indexedBandCount[node] == bandCount) {
+        return;
+    }
+
+    if (stamp != 0) {
+        staleEntryCount += store.indexedBandCount[node];
+    }
+
+    // 0 is for nodes that aren't filed
+    if (nextStamp == 0) {
+        ++nextStamp;
+    }
+
+    stamp = nextStamp++;
+    store.indexedBand[node] = firstBand;
+    store.indexedBandCount[node] = bandCount;
+
+    if (bands.size() <= lastBand) {
+        bands.resize(lastBand + 1);
+    }
+
+    for (unsigned int band = firstBand; band <= lastBand; ++band) {
+        bands[band].push_back({node, stamp});
+    }
+
+    entryCount += bandCount;
+
+    if (staleEntryCount * 2 > entryCount) {
+        sweep(store);
+    }
+}
+
+void SpatialIndex::unfile(LayoutStore& store, NodeHandle node) noexcept {
+    if (store.indexStamp[node] != 0) {
+        staleEntryCount += store.indexedBandCount[node];
+        store.indexStamp[node] = 0;
+    }
+
+    store.flags[node] &= ~SPATIALLY_INDEXED;
+}
+
+NodeHandle SpatialIndex::hitTest(const LayoutStore& store, unsigned int col,
+                                 unsigned int row) const noexcept {
+    size_t band = row / SPATIAL_INDEX_BAND_ROWS;
+    NodeHandle hit = NO_NODE;
+    unsigned int hitDepth = 0;
+
+    if (band >= bands.size()) {
+        return NO_NODE;
+    }
+
+    for (const Entry& entry : bands[band]) {
+        NodeHandle node = entry.node;
+
+        if (!isLive(store, entry) || col < store.posX[node] ||
+            col >= store.posX[node] + store.width[node] ||
+            row < store.posY[node] ||
+            row >= store.posY[node] + store.height[node]) {
+            continue;
+        }
+
+        unsigned int depth = depthOf(store, node);
+
+        if (hit == NO_NODE || depth > hitDepth) {
+            hit = node;
+            hitDepth = depth;
+        }
+    }
+
+    return hit;
+}
+
+void SpatialIndex::findNodesIn(const LayoutStore& store, unsigned int col,
+                               unsigned int row, unsigned int w,
+                               unsigned int h,
+                               vector<NodeHandle>& nodes) const {
+    if (w == 0 || h == 0 || bands.empty()) {
+        return;
+    }
+
+    size_t firstBand = row / SPATIAL_INDEX_BAND_ROWS;
+    size_t lastBand = min<size_t>((static_cast<size_t>(row) + h - 1) /
+                                      SPATIAL_INDEX_BAND_ROWS,
+                                  bands.size() - 1);
+
+    for (size_t band = firstBand; band <= lastBand; ++band) {
+        for (const Entry& entry : bands[band]) {
+            NodeHandle node = entry.node;
+
+            // a node is in every band it covers, so it is only
+            // taken from the first of them the region covers too
+            if (!isLive(store, entry) ||
+                band != max<size_t>(store.indexedBand[node], firstBand) ||
+                store.posX[node] >= col + w ||
+                col >= store.posX[node] + store.width[node] ||
+                store.posY[node] >= row + h ||
+                row >= store.posY[node] + store.height[node]) {
+                continue;
+            }
+
+            nodes.push_back(node);
+        }
+    }
+}
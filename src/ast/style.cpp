@@ -0,0 +1,177 @@
+#include <ast/style.hpp>
+#include <constants/utils.hpp>
+
+static unique_ptr<TextStyleTable> textStyleTable;
+
+TextStyleTable &getTextStyleTable() noexcept { return *textStyleTable; }
+
+void initializeTextStyleTable() {
+    assert(!textStyleTable || !"TextStyleTable must only be initialized once");
+
+    textStyleTable = make_unique<TextStyleTable>();
+}
+
+static const uint64_t FORMAT_BITS = 0x1f;
+static const uint64_t HAS_COLOR = 1 << 5;
+static const uint64_t HAS_BACKGROUND_COLOR = 1 << 6;
+static const unsigned int COLOR_SHIFT = 8;
+static const unsigned int BACKGROUND_COLOR_SHIFT = 32;
+static const uint64_t RGB_BITS = 0xffffff;
+
+/**
+ *
+ * SGR parameter of each format, in `TextNodeFormats` order
+ */
+static const char *const FORMAT_CODES[] = {"1", "3", "4", "9", "2"};
+
+static uint64_t packRgb(uint8_t r, uint8_t g, uint8_t b) noexcept {
+    return static_cast<uint64_t>(r) << 16 | static_cast<uint64_t>(g) << 8 |
+           static_cast<uint64_t>(b);
+}
+
+static tuple<uint8_t, uint8_t, uint8_t> unpackRgb(uint64_t rgb) noexcept {
+    return {static_cast<uint8_t>(rgb >> 16), static_cast<uint8_t>(rgb >> 8),
+            static_cast<uint8_t>(rgb)};
+}
+
+static void appendRgb(string &sgr, const char *code, uint64_t rgb) {
+    auto [r, g, b] = unpackRgb(rgb);
+
+    if (sgr.size() > terminal::ESC.size()) {
+        sgr += terminal::SEP;
+    }
+
+    sgr += code;
+    sgr += terminal::SEP;
+    sgr += "2";
+    sgr += terminal::SEP;
+    sgr += to_string(r);
+    sgr += terminal::SEP;
+    sgr += to_string(g);
+    sgr += terminal::SEP;
+    sgr += to_string(b);
+}
+
+TextStyle::TextStyle() noexcept : bits(0) {}
+
+TextStyle::TextStyle(uint64_t bits) noexcept : bits(bits) {}
+
+uint64_t TextStyle::getBits() const noexcept { return bits; }
+
+bool TextStyle::isPlain() const noexcept { return bits == 0; }
+
+bool TextStyle::hasFormat(TextNodeFormats format) const noexcept {
+    return bits & (1 << format);
+}
+
+void TextStyle::addFormat(TextNodeFormats format) noexcept {
+    bits |= 1 << format;
+}
+
+void TextStyle::removeFormat(TextNodeFormats format) noexcept {
+    bits &= ~static_cast<uint64_t>(1 << format);
+}
+
+void TextStyle::resetFormats() noexcept { bits &= ~FORMAT_BITS; }
+
+bool TextStyle::hasColor() const noexcept { return bits & HAS_COLOR; }
+
+tuple<uint8_t, uint8_t, uint8_t> TextStyle::getColor() const noexcept {
+    return unpackRgb(bits >> COLOR_SHIFT & RGB_BITS);
+}
+
+void TextStyle::setColor(uint8_t r, uint8_t g, uint8_t b) noexcept {
+    bits &= ~(RGB_BITS << COLOR_SHIFT);
+    bits |= HAS_COLOR | packRgb(r, g, b) << COLOR_SHIFT;
+}
+
+void TextStyle::resetColor() noexcept {
+    bits &= ~(HAS_COLOR | RGB_BITS << COLOR_SHIFT);
+}
+
+bool TextStyle::hasBackgroundColor() const noexcept {
+    return bits & HAS_BACKGROUND_COLOR;
+}
+
+tuple<uint8_t, uint8_t, uint8_t> TextStyle::getBackgroundColor()
+    const noexcept {
+    return unpackRgb(bits >> BACKGROUND_COLOR_SHIFT & RGB_BITS);
+}
+
+void TextStyle::setBackgroundColor(uint8_t r, uint8_t g, uint8_t b) noexcept {
+    bits &= ~(RGB_BITS << BACKGROUND_COLOR_SHIFT);
+    bits |= HAS_BACKGROUND_COLOR | packRgb(r, g, b) << BACKGROUND_COLOR_SHIFT;
+}
+
+void TextStyle::resetBackgroundColor() noexcept {
+    bits &= ~(HAS_BACKGROUND_COLOR | RGB_BITS << BACKGROUND_COLOR_SHIFT);
+}
+
+string TextStyle::toSgr() const {
+    if (isPlain()) {
+        return "";
+    }
+
+    string sgr(terminal::ESC);
+
+    for (unsigned int format = BOLD; format <= DIM; ++format) {
+        if (hasFormat(static_cast<TextNodeFormats>(format))) {
+            if (sgr.size() > terminal::ESC.size()) {
+                sgr += terminal::SEP;
+            }
+
+            sgr += FORMAT_CODES[format];
+        }
+    }
+
+    if (hasColor()) {
+        appendRgb(sgr, "38", bits >> COLOR_SHIFT & RGB_BITS);
+    }
+
+    if (hasBackgroundColor()) {
+        appendRgb(sgr, "48", bits >> BACKGROUND_COLOR_SHIFT & RGB_BITS);
+    }
+
+    sgr += "m";
+
+    return sgr;
+}
+
+bool TextStyle::operator==(const TextStyle &style) const noexcept {
+    return bits == style.bits;
+}
+
+bool TextStyle::operator!=(const TextStyle &style) const noexcept {
+    return bits != style.bits;
+}
+
+TextStyleTable::TextStyleTable() { intern(TextStyle()); }
+
+TextStyleId TextStyleTable::intern(TextStyle style) {
+    auto found = ids.find(style.getBits());
+
+    if (found != ids.end()) {
+        return found->second;
+    }
+
+    assert(styles.size() <= numeric_limits<TextStyleId>::max() ||
+           !"TextStyleTable ran out of ids");
+
+    TextStyleId id = static_cast<TextStyleId>(styles.size());
+
+    styles.push_back(style);
+    sgrs.push_back(style.toSgr());
+    ids.emplace(style.getBits(), id);
+
+    return id;
+}
+
+TextStyle TextStyleTable::getStyle(TextStyleId id) const noexcept {
+    return styles[id];
+}
+
+const string &TextStyleTable::getSgr(TextStyleId id) const noexcept {
+    return sgrs[id];
+}
+
+size_t TextStyleTable::size() const noexcept { return styles.size(); }
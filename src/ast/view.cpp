@@ -0,0 +1,21 @@
+#include <ast/view.hpp>
+
+GridNode* makeButtonBar(NodeArena& arena, const ButtonBarSpec& spec,
+                        unsigned int width) {
+    GridNode* bar = arena.make<GridNode>(width, 0, spec.colGap, spec.rowGap);
+
+    for (size_t i = 0; i < spec.buttonCount; ++i) {
+        const ButtonSpec& buttonSpec = spec.buttons[i];
+        ButtonNode* button = arena.make<ButtonNode>(
+            string(buttonSpec.icon), string(buttonSpec.text),
+            buttonSpec.keyCode, buttonSpec.isPressed);
+
+        if (buttonSpec.onPressed != nullptr) {
+            button->subscribe(buttonSpec.onPressed);
+        }
+
+        bar->appendChild(button);
+    }
+
+    return bar;
+}
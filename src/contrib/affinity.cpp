@@ -0,0 +1,166 @@
+#include <contrib/affinity.hpp>
+#include <contrib/state.hpp>
+
+static unique_ptr<BasketAffinity> basketAffinity;
+
+BasketAffinity& getBasketAffinity() noexcept { return *basketAffinity; }
+
+void initializeBasketAffinity() {
+    assert(!basketAffinity ||
+           !"BasketAffinity must only be initialized once");
+
+    basketAffinity =
+        make_unique<BasketAffinity>(getState().getMenuItemsData());
+
+    basketAffinity->build(ORDERS_FILE_PATH);
+
+    subscribeToSavedOrders(
+        [](const Order& order) { getBasketAffinity().recordOrder(order); });
+}
+
+BasketAffinity::BasketAffinity(const vector<MenuItemData>& menuItemsData) {
+    for (const auto& data : menuItemsData) {
+        itemIds.emplace(data.getName(), itemNames.size());
+        itemNames.push_back(data.getName());
+    }
+
+    size_t n = itemNames.size();
+
+    counts.assign(n * (n + 1) / 2, 0);
+}
+
+size_t BasketAffinity::indexOf(size_t i, size_t j) const noexcept {
+    if (i < j) {
+        swap(i, j);
+    }
+
+    return i * (i + 1) / 2 + j;
+}
+
+void BasketAffinity::collectItemIds(const Order& order,
+                                    vector<size_t>& ids) const {
+    ids.clear();
+
+    for (const auto& item : order.getItems()) {
+        auto it = itemIds.find(item.getName());
+
+        if (it != itemIds.end()) {
+            ids.push_back(it->second);
+        }
+    }
+
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+}
+
+void BasketAffinity::recordInto(vector<uint32_t>& matrix,
+                                const vector<size_t>& ids) const noexcept {
+    for (size_t a = 0, l = ids.size(); a < l; ++a) {
+        for (size_t b = 0; b <= a; ++b) {
+            ++matrix[indexOf(ids[a], ids[b])];
+        }
+    }
+}
+
+void BasketAffinity::build(const string& path) {
+    vector<streamoff> chunks =
+        splitOrdersIntoChunks(path, getOrderChunkCount(path));
+    size_t chunkCount = chunks.size() - 1;
+    vector<vector<uint32_t>> partialCounts(
+        chunkCount, vector<uint32_t>(counts.size(), 0));
+    vector<vector<size_t>> scratchIds(chunkCount);
+
+    readOrderChunksInParallel(
+        path, chunks,
+        [this, &partialCounts, &scratchIds](size_t chunk, const Order& order) {
+            if (order.getOrderState() == OrderState::CANCELLED) {
+                return;
+            }
+
+            collectItemIds(order, scratchIds.at(chunk));
+            recordInto(partialCounts.at(chunk), scratchIds.at(chunk));
+        });
+
+    fill(counts.begin(), counts.end(), 0);
+
+    for (const auto& partial : partialCounts) {
+        for (size_t i = 0, l = counts.size(); i < l; ++i) {
+            counts[i] += partial[i];
+        }
+    }
+}
+
+void BasketAffinity::recordOrder(const Order& order) {
+    if (order.getOrderState() == OrderState::CANCELLED) {
+        return;
+    }
+
+    vector<size_t> ids;
+
+    collectItemIds(order, ids);
+    recordInto(counts, ids);
+}
+
+size_t BasketAffinity::getItemCount() const noexcept {
+    return itemNames.size();
+}
+
+optional<size_t> BasketAffinity::getItemId(const string& name) const {
+    auto it = itemIds.find(name);
+
+    if (it == itemIds.end()) {
+        return nullopt;
+    }
+
+    return it->second;
+}
+
+const string& BasketAffinity::getItemName(size_t id) const {
+    return itemNames.at(id);
+}
+
+uint32_t BasketAffinity::getOccurrences(size_t id) const {
+    assert(id < itemNames.size() || !"BasketAffinity received an unknown id");
+
+    return counts[indexOf(id, id)];
+}
+
+uint32_t BasketAffinity::getCoOccurrences(size_t a, size_t b) const {
+    assert((a < itemNames.size() && b < itemNames.size()) ||
+           !"BasketAffinity received an unknown id");
+
+    return counts[indexOf(a, b)];
+}
+
+vector<size_t> BasketAffinity::rankByAffinity(
+    const vector<string>& basket) const {
+    size_t n = itemNames.size();
+    vector<double> scores(n, 0);
+    vector<size_t> ranked(n);
+
+    for (const auto& name : basket) {
+        optional<size_t> basketId = getItemId(name);
+
+        if (!basketId.has_value() || getOccurrences(basketId.value()) == 0) {
+            continue;
+        }
+
+        double occurrences = getOccurrences(basketId.value());
+
+        for (size_t id = 0; id < n; ++id) {
+            if (id != basketId.value()) {
+                scores[id] +=
+                    getCoOccurrences(id, basketId.value()) / occurrences;
+            }
+        }
+    }
+
+    for (size_t id = 0; id < n; ++id) {
+        ranked[id] = id;
+    }
+
+    stable_sort(ranked.begin(), ranked.end(),
+                [&scores](size_t a, size_t b) { return scores[a] > scores[b]; });
+
+    return ranked;
+}
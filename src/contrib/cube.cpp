@@ -0,0 +1,546 @@
+#include <contrib/cube.hpp>
+
+static unique_ptr<SalesCube> salesCube;
+
+SalesCube& getSalesCube() noexcept { return *salesCube; }
+
+void initializeSalesCube() {
+    assert(!salesCube || !"SalesCube must only be initialized once");
+
+    salesCube = make_unique<SalesCube>();
+    salesCube->loadFromStorage();
+
+    subscribeToSavedOrders(
+        [](const Order& order) { getSalesCube().append(order); });
+}
+
+static const char SALES_CUBE_MAGIC[8] = {'P', 'O', 'S', 'C',
+                                        'U', 'B', 'E', '1'};
+
+template <typename T>
+static void writeValue(ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool readValue(ifstream& file, T& value) {
+    return static_cast<bool>(
+        file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+template <typename T>
+static void writeColumn(ofstream& file,
+                        const array<T, SALES_CUBE_BATCH_SIZE>& column,
+                        size_t size) {
+    file.write(reinterpret_cast<const char*>(column.data()),
+               static_cast<streamsize>(size * sizeof(T)));
+}
+
+template <typename T>
+static bool readColumn(ifstream& file, array<T, SALES_CUBE_BATCH_SIZE>& column,
+                       size_t size) {
+    return static_cast<bool>(
+        file.read(reinterpret_cast<char*>(column.data()),
+                  static_cast<streamsize>(size * sizeof(T))));
+}
+
+static unsigned int countTrailingZeros(uint64_t word) noexcept {
+#if defined(_MSC_VER)
+    unsigned long idx;
+
+    _BitScanForward64(&idx, word);
+
+    return static_cast<unsigned int>(idx);
+#else
+    return static_cast<unsigned int>(__builtin_ctzll(word));
+#endif
+}
+
+/**
+ *
+ * Evaluates `predicate` over a whole column, 64 rows at a time, and
+ * clears the bits of the rows that don't match.
+ */
+template <typename T, typename Predicate>
+static void refineSelection(const array<T, SALES_CUBE_BATCH_SIZE>& column,
+                            size_t words, Predicate predicate,
+                            SalesSelection& selection) noexcept {
+    for (size_t w = 0; w < words; ++w) {
+        const T* values = column.data() + w * 64;
+        uint64_t matches = 0;
+
+        for (unsigned int b = 0; b < 64; ++b) {
+            matches |= static_cast<uint64_t>(predicate(values[b])) << b;
+        }
+
+        selection[w] &= matches;
+    }
+}
+
+static unsigned int dimensionBits(const SalesDimension& dimension) noexcept {
+    switch (dimension) {
+        case SalesDimension::BY_DATE:
+            return 24;
+        case SalesDimension::BY_ORDER_STATE:
+            return 8;
+        case SalesDimension::BY_ITEM:
+            return 16;
+        case SalesDimension::BY_SIZE:
+            return 8;
+    }
+
+    return 0;
+}
+
+static uint64_t dimensionValue(const SalesColumnBatch& batch, size_t row,
+                               const SalesDimension& dimension) noexcept {
+    switch (dimension) {
+        case SalesDimension::BY_DATE:
+            return static_cast<uint64_t>(batch.dates[row]) & 0xFFFFFF;
+        case SalesDimension::BY_ORDER_STATE:
+            return batch.states[row];
+        case SalesDimension::BY_ITEM:
+            return batch.items[row];
+        case SalesDimension::BY_SIZE:
+            return batch.sizes[row];
+    }
+
+    return 0;
+}
+
+SalesQuery::SalesQuery() : salesMeasure(SalesMeasure::REVENUE) {}
+
+SalesQuery& SalesQuery::between(const tm& from, const tm& to) {
+    fromDate = daysSinceEpoch(from);
+    toDate = daysSinceEpoch(to);
+
+    return *this;
+}
+
+SalesQuery& SalesQuery::withState(const OrderState& state) {
+    orderState = state;
+
+    return *this;
+}
+
+SalesQuery& SalesQuery::withoutState(const OrderState& state) {
+    excludedState = state;
+
+    return *this;
+}
+
+SalesQuery& SalesQuery::withItem(const string& name) {
+    itemName = name;
+
+    return *this;
+}
+
+SalesQuery& SalesQuery::withSize(const MenuItemSizes& size) {
+    itemSize = size;
+
+    return *this;
+}
+
+SalesQuery& SalesQuery::groupBy(const SalesDimension& dimension) {
+    unsigned int usedBits = dimensionBits(dimension);
+
+    for (const auto& d : dimensions) {
+        usedBits += dimensionBits(d);
+    }
+
+    assert(usedBits <= 64 || !"SalesQuery has too many group-bys");
+
+    dimensions.push_back(dimension);
+
+    return *this;
+}
+
+SalesQuery& SalesQuery::measure(const SalesMeasure& m) {
+    salesMeasure = m;
+
+    return *this;
+}
+
+SalesCube::SalesCube() : csvOffset(0) {}
+
+uint16_t SalesCube::internItemName(const string& name) {
+    auto it = itemIds.find(name);
+
+    if (it != itemIds.end()) {
+        return it->second;
+    }
+
+    assert(itemNames.size() < UINT16_MAX ||
+           !"SalesCube cannot hold this many distinct items");
+
+    uint16_t id = static_cast<uint16_t>(itemNames.size());
+
+    itemNames.push_back(name);
+    itemIds.emplace(name, id);
+
+    return id;
+}
+
+void SalesCube::append(const Order& order) {
+    int32_t date = static_cast<int32_t>(daysSinceEpoch(order.createdAt()));
+
+    for (const auto& item : order.getItems()) {
+        if (batches.empty() || batches.back().size == SALES_CUBE_BATCH_SIZE) {
+            batches.push_back(SalesColumnBatch());
+        }
+
+        SalesColumnBatch& batch = batches.back();
+        size_t row = batch.size++;
+
+        batch.dates[row] = date;
+        batch.states[row] = static_cast<uint8_t>(order.getOrderState());
+        batch.items[row] = internItemName(item.getName());
+        batch.sizes[row] = static_cast<uint8_t>(item.getSize());
+        batch.quantities[row] = item.getQty();
+        batch.subtotals[row] = item.calculateSubtotal();
+
+        if (row == 0 || date < batch.minDate) {
+            batch.minDate = date;
+        }
+
+        if (row == 0 || date > batch.maxDate) {
+            batch.maxDate = date;
+        }
+    }
+}
+
+size_t SalesCube::getRowCount() const noexcept {
+    if (batches.empty()) {
+        return 0;
+    }
+
+    return (batches.size() - 1) * SALES_CUBE_BATCH_SIZE + batches.back().size;
+}
+
+void SalesCube::loadFromCsv(const string& path) {
+    batches.clear();
+    itemNames.clear();
+    itemIds.clear();
+
+    OrderReader reader(path);
+
+    while (optional<Order> order = reader.next()) {
+        append(order.value());
+    }
+
+    csvOffset = reader.tell();
+}
+
+void SalesCube::loadFromStorage() {
+    error_code ec;
+    streamoff csvSize = static_cast<streamoff>(file_size(ORDERS_FILE_PATH, ec));
+
+    // the csv file got replaced or truncated since the last save
+    if (!loadBinary(SALES_CUBE_FILE_PATH) || ec || csvOffset > csvSize) {
+        loadFromCsv(ORDERS_FILE_PATH);
+    } else {
+        OrderReader reader;
+
+        if (reader.isOpen() && csvOffset > 0) {
+            reader.seek(csvOffset);
+        }
+
+        while (optional<Order> order = reader.next()) {
+            append(order.value());
+        }
+
+        csvOffset = max(csvOffset, reader.tell());
+    }
+
+    if (exists(STORAGE_DIRECTORY)) {
+        saveBinary(SALES_CUBE_FILE_PATH);
+    }
+}
+
+/**
+ *
+ * Columns are written as-is, so the file only makes sense on a
+ * machine with the same byte order. It can always be rebuilt from
+ * the csv file.
+ */
+void SalesCube::saveBinary(const string& path) const {
+    ofstream file(path, ios::binary | ios::trunc);
+
+    assert(file.is_open());
+
+    file.write(SALES_CUBE_MAGIC, sizeof(SALES_CUBE_MAGIC));
+    writeValue(file, static_cast<int64_t>(csvOffset));
+    writeValue(file, static_cast<uint32_t>(itemNames.size()));
+
+    for (const auto& name : itemNames) {
+        writeValue(file, static_cast<uint32_t>(name.size()));
+        file.write(name.data(), static_cast<streamsize>(name.size()));
+    }
+
+    writeValue(file, static_cast<uint64_t>(batches.size()));
+
+    for (const auto& batch : batches) {
+        writeValue(file, static_cast<uint32_t>(batch.size));
+        writeColumn(file, batch.dates, batch.size);
+        writeColumn(file, batch.states, batch.size);
+        writeColumn(file, batch.items, batch.size);
+        writeColumn(file, batch.sizes, batch.size);
+        writeColumn(file, batch.quantities, batch.size);
+        writeColumn(file, batch.subtotals, batch.size);
+    }
+}
+
+bool SalesCube::loadBinary(const string& path) {
+    ifstream file(path, ios::binary);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    char magic[sizeof(SALES_CUBE_MAGIC)];
+
+    if (!file.read(magic, sizeof(magic)) ||
+        !equal(magic, magic + sizeof(magic), SALES_CUBE_MAGIC)) {
+        return false;
+    }
+
+    int64_t offset = 0;
+    uint32_t nameCount = 0;
+    uint64_t batchCount = 0;
+
+    batches.clear();
+    itemNames.clear();
+    itemIds.clear();
+
+    if (!readValue(file, offset) || !readValue(file, nameCount)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < nameCount; ++i) {
+        uint32_t length = 0;
+
+        if (!readValue(file, length)) {
+            return false;
+        }
+
+        string name(length, '\0');
+
+        if (!file.read(name.data(), length)) {
+            return false;
+        }
+
+        internItemName(name);
+    }
+
+    if (!readValue(file, batchCount)) {
+        return false;
+    }
+
+    for (uint64_t i = 0; i < batchCount; ++i) {
+        uint32_t size = 0;
+
+        if (!readValue(file, size) || size > SALES_CUBE_BATCH_SIZE) {
+            batches.clear();
+
+            return false;
+        }
+
+        batches.push_back(SalesColumnBatch());
+
+        SalesColumnBatch& batch = batches.back();
+
+        batch.size = size;
+
+        if (!readColumn(file, batch.dates, size) ||
+            !readColumn(file, batch.states, size) ||
+            !readColumn(file, batch.items, size) ||
+            !readColumn(file, batch.sizes, size) ||
+            !readColumn(file, batch.quantities, size) ||
+            !readColumn(file, batch.subtotals, size)) {
+            batches.clear();
+
+            return false;
+        }
+
+        if (size > 0) {
+            auto [minIt, maxIt] = minmax_element(batch.dates.begin(),
+                                                 batch.dates.begin() + size);
+
+            batch.minDate = *minIt;
+            batch.maxDate = *maxIt;
+        }
+    }
+
+    csvOffset = static_cast<streamoff>(offset);
+
+    return true;
+}
+
+void SalesCube::selectBatch(const SalesColumnBatch& batch,
+                            const SalesQuery& query, optional<uint16_t> itemId,
+                            SalesSelection& selection) const noexcept {
+    size_t words = (batch.size + 63) / 64;
+
+    selection.fill(0);
+
+    for (size_t w = 0; w < words; ++w) {
+        selection[w] = ~static_cast<uint64_t>(0);
+    }
+
+    if (batch.size % 64 != 0) {
+        selection[words - 1] =
+            (static_cast<uint64_t>(1) << (batch.size % 64)) - 1;
+    }
+
+    if (query.fromDate.has_value()) {
+        int32_t from = static_cast<int32_t>(query.fromDate.value());
+        int32_t to = static_cast<int32_t>(query.toDate.value());
+
+        refineSelection(
+            batch.dates, words,
+            [from, to](int32_t date) { return (date >= from) & (date <= to); },
+            selection);
+    }
+
+    if (query.orderState.has_value()) {
+        uint8_t state = static_cast<uint8_t>(query.orderState.value());
+
+        refineSelection(
+            batch.states, words, [state](uint8_t s) { return s == state; },
+            selection);
+    }
+
+    if (query.excludedState.has_value()) {
+        uint8_t state = static_cast<uint8_t>(query.excludedState.value());
+
+        refineSelection(
+            batch.states, words, [state](uint8_t s) { return s != state; },
+            selection);
+    }
+
+    if (itemId.has_value()) {
+        uint16_t item = itemId.value();
+
+        refineSelection(
+            batch.items, words, [item](uint16_t i) { return i == item; },
+            selection);
+    }
+
+    if (query.itemSize.has_value()) {
+        uint8_t size = static_cast<uint8_t>(query.itemSize.value());
+
+        refineSelection(
+            batch.sizes, words, [size](uint8_t s) { return s == size; },
+            selection);
+    }
+}
+
+string SalesCube::keyToString(const SalesDimension& dimension,
+                              uint64_t value) const {
+    switch (dimension) {
+        case SalesDimension::BY_DATE:
+            return parseDate(
+                dateFromDaysSinceEpoch(static_cast<long>(value)));
+        case SalesDimension::BY_ORDER_STATE:
+            return orderStateToString(static_cast<OrderState>(value));
+        case SalesDimension::BY_ITEM:
+            return itemNames.at(value);
+        case SalesDimension::BY_SIZE:
+            return toString(static_cast<MenuItemSizes>(value));
+    }
+
+    return "";
+}
+
+vector<SalesCubeRow> SalesCube::run(const SalesQuery& query) const {
+    struct Accumulator {
+        size_t count = 0;
+        double sum = 0;
+    };
+
+    optional<uint16_t> itemId;
+
+    if (query.itemName.has_value()) {
+        auto it = itemIds.find(query.itemName.value());
+
+        // nothing can match an item that was never sold
+        if (it == itemIds.end()) {
+            return {};
+        }
+
+        itemId = it->second;
+    }
+
+    unordered_map<uint64_t, Accumulator> groups;
+    SalesSelection selection;
+
+    for (const auto& batch : batches) {
+        if (batch.size == 0) {
+            continue;
+        }
+
+        if (query.fromDate.has_value() &&
+            (batch.maxDate < query.fromDate.value() ||
+             batch.minDate > query.toDate.value())) {
+            continue;
+        }
+
+        selectBatch(batch, query, itemId, selection);
+
+        for (size_t w = 0; w < SALES_CUBE_SELECTION_WORDS; ++w) {
+            uint64_t word = selection[w];
+
+            while (word != 0) {
+                size_t row = w * 64 + countTrailingZeros(word);
+                uint64_t key = 0;
+
+                word &= word - 1;
+
+                for (const auto& dimension : query.dimensions) {
+                    key = (key << dimensionBits(dimension)) |
+                          dimensionValue(batch, row, dimension);
+                }
+
+                Accumulator& accumulator = groups[key];
+
+                accumulator.count += 1;
+                accumulator.sum +=
+                    query.salesMeasure == SalesMeasure::QUANTITY
+                        ? static_cast<double>(batch.quantities[row])
+                        : batch.subtotals[row];
+            }
+        }
+    }
+
+    vector<pair<uint64_t, Accumulator>> sortedGroups(groups.begin(),
+                                                     groups.end());
+
+    sort(sortedGroups.begin(), sortedGroups.end(),
+         [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    vector<SalesCubeRow> rows;
+
+    for (const auto& [key, accumulator] : sortedGroups) {
+        SalesCubeRow row = {{},
+                            accumulator.count,
+                            accumulator.sum,
+                            accumulator.sum /
+                                static_cast<double>(accumulator.count)};
+        unsigned int shift = 0;
+
+        // keys were packed with the first dimension in the highest bits
+        for (size_t i = query.dimensions.size(); i-- > 0;) {
+            const SalesDimension& dimension = query.dimensions.at(i);
+            unsigned int bits = dimensionBits(dimension);
+            uint64_t value =
+                (key >> shift) & ((static_cast<uint64_t>(1) << bits) - 1);
+
+            row.keys.insert(row.keys.begin(), keyToString(dimension, value));
+            shift += bits;
+        }
+
+        rows.push_back(row);
+    }
+
+    return rows;
+}
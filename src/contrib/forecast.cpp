@@ -0,0 +1,252 @@
+#include <contrib/forecast.hpp>
+
+static unique_ptr<DemandForecaster> demandForecaster;
+
+DemandForecaster& getDemandForecaster() noexcept { return *demandForecaster; }
+
+void initializeDemandForecaster() {
+    assert(!demandForecaster ||
+           !"DemandForecaster must only be initialized once");
+
+    demandForecaster = make_unique<DemandForecaster>();
+    demandForecaster->train(ORDERS_FILE_PATH);
+
+    subscribeToSavedOrders(
+        [](const Order& order) { getDemandForecaster().recordOrder(order); });
+}
+
+static long weekOfHour(long hoursSinceEpoch) noexcept {
+    long day = hoursSinceEpoch / 24;
+
+    if (hoursSinceEpoch % 24 < 0) {
+        --day;
+    }
+
+    return weekOfEpochDay(day);
+}
+
+ItemDemandModel::ItemDemandModel()
+    : hourlyQuantities(),
+      totalQuantity(0),
+      weekCount(0),
+      sumWeeks(0),
+      sumQuantities(0),
+      sumWeeksQuantities(0),
+      sumWeeksSquared(0),
+      currentWeek(-1),
+      currentWeekQuantity(0) {}
+
+void ItemDemandModel::record(long hour, double quantity) noexcept {
+    long week = weekOfHour(hour);
+
+    hourlyQuantities.at(hourOfWeek(hour)) += quantity;
+    totalQuantity += quantity;
+
+    closeWeeksUntil(week);
+
+    // late orders only count towards the seasonal part since
+    // their week is already part of the fit
+    if (week == currentWeek) {
+        currentWeekQuantity += quantity;
+    }
+}
+
+void ItemDemandModel::closeWeeksUntil(long week) noexcept {
+    if (currentWeek < 0) {
+        currentWeek = week;
+
+        return;
+    }
+
+    for (; currentWeek < week; ++currentWeek) {
+        double x = static_cast<double>(currentWeek);
+
+        weekCount += 1;
+        sumWeeks += x;
+        sumQuantities += currentWeekQuantity;
+        sumWeeksQuantities += x * currentWeekQuantity;
+        sumWeeksSquared += x * x;
+
+        currentWeekQuantity = 0;
+    }
+}
+
+void ItemDemandModel::fit(
+    const array<double, DEMAND_FORECAST_HOURS>& hourly,
+    const map<long, double>& weekly, long firstWeek, long lastWeek) noexcept {
+    *this = ItemDemandModel();
+
+    hourlyQuantities = hourly;
+
+    for (const auto& quantity : hourly) {
+        totalQuantity += quantity;
+    }
+
+    auto it = weekly.begin();
+
+    currentWeek = firstWeek;
+
+    for (long week = firstWeek; week <= lastWeek; ++week) {
+        closeWeeksUntil(week);
+
+        while (it != weekly.end() && it->first < week) {
+            ++it;
+        }
+
+        if (it != weekly.end() && it->first == week) {
+            currentWeekQuantity = it->second;
+        }
+    }
+}
+
+double ItemDemandModel::getWeeklyQuantity(long week) const noexcept {
+    // nothing closed yet, the open week is all there is
+    if (weekCount == 0) {
+        return currentWeekQuantity;
+    }
+
+    double denominator = weekCount * sumWeeksSquared - sumWeeks * sumWeeks;
+
+    if (weekCount < 2 || denominator <= 0) {
+        return sumQuantities / weekCount;
+    }
+
+    double slope =
+        (weekCount * sumWeeksQuantities - sumWeeks * sumQuantities) /
+        denominator;
+    double intercept = (sumQuantities - slope * sumWeeks) / weekCount;
+
+    return max(0.0, intercept + slope * static_cast<double>(week));
+}
+
+double ItemDemandModel::forecast(long hour) const noexcept {
+    if (totalQuantity <= 0) {
+        return 0;
+    }
+
+    long week = weekOfHour(hour);
+
+    return getWeeklyQuantity(week) * hourlyQuantities.at(hourOfWeek(hour)) /
+           totalQuantity;
+}
+
+DemandForecaster::DemandForecaster() : currentWeek(-1) {}
+
+/**
+ *
+ * The fit needs every week of an item in order, which a chunk
+ * doesn't have, so chunks only sum up quantities per hour of week
+ * and per week. The models are fitted once those are merged.
+ */
+void DemandForecaster::train(const string& path) {
+    vector<streamoff> chunks =
+        splitOrdersIntoChunks(path, getOrderChunkCount(path));
+    vector<ChunkHistory> histories(chunks.size() - 1);
+
+    readOrderChunksInParallel(
+        path, chunks, [&histories](size_t chunk, const Order& order) {
+            if (order.getOrderState() == OrderState::CANCELLED) {
+                return;
+            }
+
+            ChunkHistory& history = histories.at(chunk);
+            tm createdAt = order.createdAt();
+            long day = daysSinceEpoch(createdAt);
+            long week = weekOfEpochDay(day);
+            size_t hour = hourOfWeek(day * 24 + createdAt.tm_hour);
+
+            if (history.firstWeek < 0 || week < history.firstWeek) {
+                history.firstWeek = week;
+            }
+
+            history.lastWeek = max(history.lastWeek, week);
+
+            for (const auto& item : order.getItems()) {
+                ItemHistory& itemHistory = history.items[item.getName()];
+
+                itemHistory.hourly.at(hour) += item.getQty();
+                itemHistory.weekly[week] += item.getQty();
+            }
+        });
+
+    ChunkHistory merged;
+
+    for (auto& history : histories) {
+        if (history.firstWeek < 0) {
+            continue;
+        }
+
+        if (merged.firstWeek < 0 || history.firstWeek < merged.firstWeek) {
+            merged.firstWeek = history.firstWeek;
+        }
+
+        merged.lastWeek = max(merged.lastWeek, history.lastWeek);
+
+        for (auto& [name, itemHistory] : history.items) {
+            ItemHistory& mergedItem = merged.items[name];
+
+            for (size_t h = 0; h < DEMAND_FORECAST_HOURS; ++h) {
+                mergedItem.hourly[h] += itemHistory.hourly[h];
+            }
+
+            for (const auto& [week, quantity] : itemHistory.weekly) {
+                mergedItem.weekly[week] += quantity;
+            }
+        }
+    }
+
+    models.clear();
+    currentWeek = merged.lastWeek;
+
+    for (const auto& [name, itemHistory] : merged.items) {
+        models[name].fit(itemHistory.hourly, itemHistory.weekly,
+                         merged.firstWeek, merged.lastWeek);
+    }
+}
+
+void DemandForecaster::recordOrder(const Order& order) {
+    if (order.getOrderState() == OrderState::CANCELLED) {
+        return;
+    }
+
+    tm createdAt = order.createdAt();
+    long day = daysSinceEpoch(createdAt);
+    long week = weekOfEpochDay(day);
+    long hour = day * 24 + createdAt.tm_hour;
+
+    // every item gets its zero weeks, not only the ones in the order
+    if (week > currentWeek) {
+        for (auto& [name, model] : models) {
+            model.closeWeeksUntil(week);
+        }
+
+        currentWeek = week;
+    }
+
+    for (const auto& item : order.getItems()) {
+        models[item.getName()].record(hour, item.getQty());
+    }
+}
+
+double DemandForecaster::forecast(const string& itemName,
+                                  const tm& now) const noexcept {
+    return forecast(itemName, now, 1);
+}
+
+double DemandForecaster::forecast(const string& itemName, const tm& now,
+                                  unsigned int hours) const noexcept {
+    auto it = models.find(itemName);
+
+    if (it == models.end()) {
+        return 0;
+    }
+
+    long hour = daysSinceEpoch(now) * 24 + now.tm_hour;
+    double quantity = 0;
+
+    for (unsigned int h = 0; h < hours; ++h) {
+        quantity += it->second.forecast(hour + h);
+    }
+
+    return quantity;
+}
@@ -0,0 +1,282 @@
+#include <contrib/grading.hpp>
+
+static unique_ptr<SalesGrader> salesGrader;
+
+SalesGrader& getSalesGrader() noexcept { return *salesGrader; }
+
+void initializeSalesGrader() {
+    assert(!salesGrader || !"SalesGrader must only be initialized once");
+
+    salesGrader = make_unique<SalesGrader>();
+
+    OrderReader reader;
+
+    while (optional<Order> order = reader.next()) {
+        salesGrader->recordOrder(order.value());
+    }
+
+    subscribeToSavedOrders(
+        [](const Order& order) { getSalesGrader().recordOrder(order); });
+}
+
+string salesGradeToString(const SalesGrade& grade) noexcept {
+    switch (grade) {
+        case SalesGrade::UNGRADED:
+            return "UNGRADED";
+        case SalesGrade::UNDERPERFORMING:
+            return "UNDERPERFORMING";
+        case SalesGrade::ON_TRACK:
+            return "ON TRACK";
+        case SalesGrade::OVERPERFORMING:
+            return "OVERPERFORMING";
+    }
+
+    return "";
+}
+
+ExponentialMovingAverage::ExponentialMovingAverage()
+    : ExponentialMovingAverage(SALES_BASELINE_ALPHA) {}
+
+ExponentialMovingAverage::ExponentialMovingAverage(double a)
+    : alpha(a), value(0), hasValue(false) {
+    assert((a > 0 && a <= 1) || !"alpha must be in (0, 1]");
+}
+
+void ExponentialMovingAverage::update(double sample) noexcept {
+    if (!hasValue) {
+        value = sample;
+        hasValue = true;
+
+        return;
+    }
+
+    value += alpha * (sample - value);
+}
+
+double ExponentialMovingAverage::getValue() const noexcept { return value; }
+
+RollingPercentiles::RollingPercentiles() : samples(), head(0), count(0) {}
+
+void RollingPercentiles::push(double sample) noexcept {
+    samples.at(head) = sample;
+    head = (head + 1) % SALES_BASELINE_WINDOW;
+
+    if (count < SALES_BASELINE_WINDOW) {
+        ++count;
+    }
+}
+
+double RollingPercentiles::percentile(double p) const noexcept {
+    if (count == 0) {
+        return 0;
+    }
+
+    array<double, SALES_BASELINE_WINDOW> sorted = samples;
+    size_t rank = static_cast<size_t>(p * static_cast<double>(count - 1) + 0.5);
+
+    nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + count);
+
+    return sorted.at(rank);
+}
+
+size_t RollingPercentiles::getCount() const noexcept { return count; }
+
+SalesBaseline::SalesBaseline() {}
+
+void SalesBaseline::update(double revenue) noexcept {
+    average.update(revenue);
+    percentiles.push(revenue);
+}
+
+double SalesBaseline::getExpected() const noexcept {
+    return average.getValue();
+}
+
+SalesGradeResult SalesBaseline::grade(double revenue,
+                                      double elapsedFraction) const noexcept {
+    double fraction = clamp(elapsedFraction, 0.0, 1.0);
+    SalesGradeResult result = {
+        SalesGrade::UNGRADED, revenue, average.getValue() * fraction,
+        percentiles.percentile(SALES_BASELINE_LOW_PERCENTILE) * fraction,
+        percentiles.percentile(SALES_BASELINE_HIGH_PERCENTILE) * fraction};
+
+    if (percentiles.getCount() < SALES_BASELINE_MIN_SAMPLES) {
+        return result;
+    }
+
+    if (revenue < result.low) {
+        result.grade = SalesGrade::UNDERPERFORMING;
+    } else if (revenue > result.high) {
+        result.grade = SalesGrade::OVERPERFORMING;
+    } else {
+        result.grade = SalesGrade::ON_TRACK;
+    }
+
+    return result;
+}
+
+SalesGrader::SalesGrader()
+    : currentHour(-1),
+      currentHourRevenue(0),
+      currentDay(-1),
+      currentDayRevenue(0) {}
+
+void SalesGrader::advanceToHour(long hour) noexcept {
+    if (currentHour < 0) {
+        currentHour = hour;
+
+        return;
+    }
+
+    // late orders stay in the open bucket since closed ones are
+    // already part of the baseline
+    if (hour <= currentHour) {
+        return;
+    }
+
+    hourlyBaselines.at(hourOfWeek(currentHour)).update(currentHourRevenue);
+
+    // Hours without any order count as zero sales. Past a week,
+    // every bucket has already received one.
+    for (long h = currentHour + 1, l = min(hour, currentHour + 7 * 24); h < l;
+         ++h) {
+        hourlyBaselines.at(hourOfWeek(h)).update(0);
+    }
+
+    currentHour = hour;
+    currentHourRevenue = 0;
+}
+
+void SalesGrader::advanceToDay(long day) noexcept {
+    if (currentDay < 0) {
+        currentDay = day;
+
+        return;
+    }
+
+    if (day <= currentDay) {
+        return;
+    }
+
+    dailyBaselines.at(weekdayOfEpochDay(currentDay)).update(currentDayRevenue);
+
+    for (long d = currentDay + 1, l = min(day, currentDay + 7); d < l; ++d) {
+        dailyBaselines.at(weekdayOfEpochDay(d)).update(0);
+    }
+
+    currentDay = day;
+    currentDayRevenue = 0;
+}
+
+/**
+ *
+ * Items are closed lazily on their next sale so that an order only
+ * pays for the items in it. Days in between without a sale of the
+ * item count as zero sales then.
+ */
+void SalesGrader::advanceItemToDay(ItemTracker& tracker, long day) noexcept {
+    if (tracker.currentDay < 0) {
+        tracker.currentDay = day;
+
+        return;
+    }
+
+    if (day <= tracker.currentDay) {
+        return;
+    }
+
+    tracker.dailyBaselines.at(weekdayOfEpochDay(tracker.currentDay))
+        .update(tracker.currentDayRevenue);
+
+    for (long d = tracker.currentDay + 1, l = min(day, tracker.currentDay + 7);
+         d < l; ++d) {
+        tracker.dailyBaselines.at(weekdayOfEpochDay(d)).update(0);
+    }
+
+    tracker.currentDay = day;
+    tracker.currentDayRevenue = 0;
+}
+
+void SalesGrader::recordOrder(const Order& order) {
+    if (order.getOrderState() == OrderState::CANCELLED) {
+        return;
+    }
+
+    tm createdAt = order.createdAt();
+    long day = daysSinceEpoch(createdAt);
+    long hour = day * 24 + createdAt.tm_hour;
+    double revenue = order.getTotalPrice();
+
+    advanceToHour(hour);
+    advanceToDay(day);
+
+    currentHourRevenue += revenue;
+    currentDayRevenue += revenue;
+
+    for (const auto& item : order.getItems()) {
+        ItemTracker& tracker = itemTrackers[item.getName()];
+
+        advanceItemToDay(tracker, day);
+
+        tracker.currentDayRevenue += item.calculateSubtotal();
+    }
+}
+
+double SalesGrader::expectedFractionOfDay(const tm& now) const noexcept {
+    size_t firstHour = weekdayOfEpochDay(daysSinceEpoch(now)) * 24;
+    double minutesIntoHour = (now.tm_min * 60 + now.tm_sec) / 3600.0;
+    double expectedSoFar = 0;
+    double expectedTotal = 0;
+
+    for (size_t h = 0; h < 24; ++h) {
+        double expected = hourlyBaselines.at(firstHour + h).getExpected();
+
+        expectedTotal += expected;
+
+        if (h < static_cast<size_t>(now.tm_hour)) {
+            expectedSoFar += expected;
+        } else if (h == static_cast<size_t>(now.tm_hour)) {
+            expectedSoFar += expected * minutesIntoHour;
+        }
+    }
+
+    // no hourly history to go by
+    if (expectedTotal <= 0) {
+        return (now.tm_hour + minutesIntoHour) / 24.0;
+    }
+
+    return expectedSoFar / expectedTotal;
+}
+
+SalesGradeResult SalesGrader::gradeHour(const tm& now) const noexcept {
+    long hour = daysSinceEpoch(now) * 24 + now.tm_hour;
+    double revenue = hour == currentHour ? currentHourRevenue : 0;
+    double elapsed = (now.tm_min * 60 + now.tm_sec) / 3600.0;
+
+    return hourlyBaselines.at(hourOfWeek(hour)).grade(revenue, elapsed);
+}
+
+SalesGradeResult SalesGrader::gradeDay(const tm& now) const noexcept {
+    long day = daysSinceEpoch(now);
+    double revenue = day == currentDay ? currentDayRevenue : 0;
+
+    return dailyBaselines.at(weekdayOfEpochDay(day))
+        .grade(revenue, expectedFractionOfDay(now));
+}
+
+SalesGradeResult SalesGrader::gradeItem(const string& itemName,
+                                        const tm& now) const noexcept {
+    long day = daysSinceEpoch(now);
+    auto it = itemTrackers.find(itemName);
+
+    if (it == itemTrackers.end()) {
+        return SalesBaseline().grade(0, 1);
+    }
+
+    const ItemTracker& tracker = it->second;
+    double revenue =
+        tracker.currentDay == day ? tracker.currentDayRevenue : 0;
+
+    return tracker.dailyBaselines.at(weekdayOfEpochDay(day))
+        .grade(revenue, expectedFractionOfDay(now));
+}
@@ -0,0 +1,242 @@
+#include <contrib/report.hpp>
+
+ZReport::ZReport(const tm& day)
+    : date(parseDate(day)),
+      orderCount(0),
+      stateCounts(),
+      grossSales(0),
+      VAT(0),
+      cancelledSales(0),
+      itemsSold(0) {}
+
+void ZReport::record(const Order& order) {
+    OrderState orderState = order.getOrderState();
+    string createdAt = parseDateTime(order.createdAt());
+
+    ++orderCount;
+    ++stateCounts.at(orderState);
+
+    if (!firstOrderUid.has_value() || createdAt < firstOrderTime) {
+        firstOrderUid = order.getOrderUid();
+        firstOrderTime = createdAt;
+    }
+
+    if (!lastOrderUid.has_value() || createdAt >= lastOrderTime) {
+        lastOrderUid = order.getOrderUid();
+        lastOrderTime = createdAt;
+    }
+
+    if (orderState == OrderState::CANCELLED) {
+        cancelledSales += order.getTotalPrice();
+
+        return;
+    }
+
+    grossSales += order.getTotalPrice();
+    VAT += order.getVAT();
+
+    for (const auto& item : order.getItems()) {
+        ZReportItemLine& line = itemMix[item.getName()];
+
+        line.quantity += item.getQty();
+        line.sales += item.calculateSubtotal();
+        itemsSold += item.getQty();
+    }
+}
+
+string ZReport::getDate() const noexcept { return date; }
+
+size_t ZReport::getOrderCount() const noexcept { return orderCount; }
+
+size_t ZReport::getOrderCount(const OrderState& orderState) const noexcept {
+    return stateCounts.at(orderState);
+}
+
+double ZReport::getGrossSales() const noexcept { return grossSales; }
+
+double ZReport::getVAT() const noexcept { return VAT; }
+
+double ZReport::getNetSales() const noexcept { return grossSales - VAT; }
+
+double ZReport::getCancelledSales() const noexcept { return cancelledSales; }
+
+uint32_t ZReport::getItemsSold() const noexcept { return itemsSold; }
+
+const map<string, ZReportItemLine>& ZReport::getItemMix() const noexcept {
+    return itemMix;
+}
+
+vector<string> ZReport::toLines() const {
+    vector<string> lines = {
+        "Z-REPORT " + date,
+        "Orders: " + to_string(orderCount) + " (" +
+            to_string(stateCounts.at(OrderState::PENDING)) + " pending, " +
+            to_string(stateCounts.at(OrderState::FINISHED)) + " finished, " +
+            to_string(stateCounts.at(OrderState::CANCELLED)) + " cancelled)",
+        "Gross sales: ₱" + formatNumber(grossSales),
+        "VATable sales: ₱" + formatNumber(getNetSales()),
+        "VAT (" + formatNumber(TAX * 100) + "%): ₱" + formatNumber(VAT),
+        "Cancelled: ₱" + formatNumber(cancelledSales),
+        "Items sold: " + to_string(itemsSold)};
+
+    if (firstOrderUid.has_value()) {
+        lines.push_back("First order: " + firstOrderUid.value() + " at " +
+                        firstOrderTime);
+        lines.push_back("Last order: " + lastOrderUid.value() + " at " +
+                        lastOrderTime);
+    }
+
+    for (const auto& [name, line] : itemMix) {
+        lines.push_back("  " + name + " x" + to_string(line.quantity) +
+                        " ₱" + formatNumber(line.sales));
+    }
+
+    return lines;
+}
+
+/**
+ *
+ * Written next to the checkpoint first and then renamed over it so
+ * an interruption never leaves half a checkpoint behind.
+ */
+void ZReport::saveCheckpoint(const string& path, streamoff offset) const {
+    string tempPath = path + ".tmp";
+
+    {
+        ofstream file(tempPath, ios::trunc);
+
+        assert(file.is_open());
+
+        file << setprecision(numeric_limits<double>::max_digits10);
+        file << "date," << date << "\n";
+        file << "offset," << offset << "\n";
+        file << "orders," << orderCount << "\n";
+        file << "states," << stateCounts.at(0) << "," << stateCounts.at(1)
+             << "," << stateCounts.at(2) << "\n";
+        file << "gross," << grossSales << "\n";
+        file << "vat," << VAT << "\n";
+        file << "cancelled," << cancelledSales << "\n";
+        file << "items," << itemsSold << "\n";
+
+        if (firstOrderUid.has_value()) {
+            file << "first," << firstOrderUid.value() << "," << firstOrderTime
+                 << "\n";
+            file << "last," << lastOrderUid.value() << "," << lastOrderTime
+                 << "\n";
+        }
+
+        for (const auto& [name, line] : itemMix) {
+            file << "item," << name << "," << line.quantity << ","
+                 << line.sales << "\n";
+        }
+    }
+
+    filesystem::rename(tempPath, path);
+}
+
+optional<streamoff> ZReport::loadCheckpoint(const string& path) {
+    ifstream file(path);
+    string line;
+    optional<streamoff> offset;
+
+    if (!file.is_open() || !getline(file, line) || line != "date," + date) {
+        return nullopt;
+    }
+
+    ZReport restored(*this);
+
+    while (getline(file, line)) {
+        stringstream lineSS(line);
+        vector<string> cells;
+        string cell;
+
+        while (getline(lineSS, cell, ',')) {
+            cells.push_back(cell);
+        }
+
+        if (cells.size() < 2) {
+            continue;
+        }
+
+        const string& key = cells.at(0);
+
+        // todo: handle invalid value with try-catch
+        if (key == "offset") {
+            offset = stoll(cells.at(1));
+        } else if (key == "orders") {
+            restored.orderCount = stoul(cells.at(1));
+        } else if (key == "states" && cells.size() == 4) {
+            for (size_t i = 0; i < 3; ++i) {
+                restored.stateCounts.at(i) = stoul(cells.at(i + 1));
+            }
+        } else if (key == "gross") {
+            restored.grossSales = stod(cells.at(1));
+        } else if (key == "vat") {
+            restored.VAT = stod(cells.at(1));
+        } else if (key == "cancelled") {
+            restored.cancelledSales = stod(cells.at(1));
+        } else if (key == "items") {
+            restored.itemsSold = static_cast<uint32_t>(stoul(cells.at(1)));
+        } else if (key == "first" && cells.size() == 3) {
+            restored.firstOrderUid = cells.at(1);
+            restored.firstOrderTime = cells.at(2);
+        } else if (key == "last" && cells.size() == 3) {
+            restored.lastOrderUid = cells.at(1);
+            restored.lastOrderTime = cells.at(2);
+        } else if (key == "item" && cells.size() == 4) {
+            restored.itemMix[cells.at(1)] = {
+                static_cast<uint32_t>(stoul(cells.at(2))), stod(cells.at(3))};
+        }
+    }
+
+    if (offset.has_value()) {
+        *this = restored;
+    }
+
+    return offset;
+}
+
+ZReport generateZReport(const tm& day) {
+    return generateZReport(day, ORDERS_FILE_PATH, Z_REPORT_CHECKPOINT_PATH);
+}
+
+ZReport generateZReport(const tm& day, const string& ordersPath,
+                        const string& checkpointPath) {
+    ZReport report(day);
+    OrderReader reader(ordersPath);
+
+    if (!reader.isOpen()) {
+        return report;
+    }
+
+    error_code ec;
+    streamoff ordersSize =
+        static_cast<streamoff>(filesystem::file_size(ordersPath, ec));
+    optional<streamoff> resumeOffset = report.loadCheckpoint(checkpointPath);
+
+    // a checkpoint past the end belongs to a file that has since
+    // been replaced
+    if (resumeOffset.has_value() && !ec &&
+        resumeOffset.value() <= ordersSize) {
+        reader.seek(resumeOffset.value());
+    } else if (resumeOffset.has_value()) {
+        report = ZReport(day);
+    }
+
+    reader.filterByDate(day);
+
+    size_t sinceCheckpoint = 0;
+
+    while (optional<Order> order = reader.next()) {
+        report.record(order.value());
+
+        if (++sinceCheckpoint == Z_REPORT_CHECKPOINT_INTERVAL) {
+            report.saveCheckpoint(checkpointPath, reader.tell());
+            sinceCheckpoint = 0;
+        }
+    }
+
+    filesystem::remove(checkpointPath, ec);
+
+    return report;
+}
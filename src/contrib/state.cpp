@@ -35,6 +35,23 @@ void initializeMenuItemSizesSelectData() {
 	state.appendMenuItemSizeData(trenta);
 }
 
+/**
+ *
+ * Forecasts every item on the menu for the next
+ * `DEMAND_PREP_WINDOW_HOURS` from now
+ */
+static void stagePrepForecasts() {
+    State& state = getState();
+    DemandForecaster& forecaster = getDemandForecaster();
+    tm now = getCurrentDateTime();
+
+    for (const auto& data : state.getMenuItemsData()) {
+        state.setPrepForecast(
+            data.getName(),
+            forecaster.forecast(data.getName(), now, DEMAND_PREP_WINDOW_HOURS));
+    }
+}
+
 void initializeMenuItemSelectData() {
 	State& state = getState();
 
@@ -88,6 +105,12 @@ void initializeMenuItemSelectData() {
     state.appendMenuItemData(item8);
     state.appendMenuItemData(item9);
     state.appendMenuItemData(item10);
+
+    stagePrepForecasts();
+
+    // the forecaster was subscribed first, so it has taken the
+    // order in by the time this runs
+    subscribeToSavedOrders([](const Order&) { stagePrepForecasts(); });
 }
 
 void initializeMenuItemAddonSelectData()
@@ -312,3 +335,13 @@ void State::clearMenuItemsInCart() noexcept {
 const vector<MenuItemSizeData>& State::getMenuItemSizesData() const noexcept {
     return menuItemSizesData;
 }
+
+double State::getPrepForecast(const string& itemName) const noexcept {
+    auto it = prepForecasts.find(itemName);
+
+    return it == prepForecasts.end() ? 0 : it->second;
+}
+
+void State::setPrepForecast(const string& itemName, const double& quantity) {
+    prepForecasts[itemName] = quantity;
+}
@@ -1,8 +1,74 @@
 #include <contrib/storage.hpp>
 
+static vector<OrderSavedCallback> savedOrderSubscribers;
+
+/**
+ *
+ * Rows saved before the VAT column was added only have 11 cells.
+ */
+static bool rowHasVATColumn(const vector<string>& row) {
+    return row.size() > 11;
+}
+
+static MenuItem menuItemFromRow(const vector<string>& row) {
+    string itemId = row.at(1);
+    string itemName = row.at(3);
+    // todo: handle invalid value with try-catch
+    double basePrice = stod(row.at(4));
+    MenuItemSizes itemSize = fromString(row.at(5));
+    uint8_t itemQty = static_cast<uint8_t>(stoul(row.at(6)));
+    const string& remarksCell = row.at(rowHasVATColumn(row) ? 10 : 9);
+    optional<string> remarks =
+        remarksCell.empty() ? nullopt : optional(remarksCell);
+
+    return MenuItem(itemId, itemName, basePrice, itemSize, itemQty, remarks);
+}
+
+static void orderMetadataFromRow(const vector<string>& row, tm& dateCreated,
+                                 OrderState& orderState, double& totalPrice,
+                                 double& VAT) {
+    dateCreated = parseDateTime(row.at(2));
+    totalPrice = stod(row.at(8));
+
+    if (rowHasVATColumn(row)) {
+        VAT = stod(row.at(9));
+        orderState = orderStateFromString(row.at(11));
+    } else {
+        VAT = totalPrice - totalPrice / (1 + TAX);
+        orderState = orderStateFromString(row.at(10));
+    }
+}
+
+// Gives the same cells as splitting with `getline()` on ',' but
+// without going through a stringstream for every row.
+static void splitRow(const string& line, vector<string>& row) {
+    size_t start = 0;
+    size_t comma;
+
+    row.clear();
+
+    while ((comma = line.find(',', start)) != string::npos) {
+        row.emplace_back(line, start, comma - start);
+        start = comma + 1;
+    }
+
+    if (start < line.size()) {
+        row.emplace_back(line, start);
+    }
+}
+
+static bool rowCreatedOn(const string& line, const string& date) {
+    size_t first = line.find(',');
+    size_t second =
+        first == string::npos ? string::npos : line.find(',', first + 1);
+
+    return second != string::npos &&
+           line.compare(second + 1, date.size(), date) == 0;
+}
+
 Order::Order(const vector<MenuItem>& menuItems)
     : items(menuItems),
-      dateCreated(parseDate(getCurrentDate())),
+      dateCreated(getCurrentDateTime()),
       orderState(OrderState::PENDING) {
     totalPrice = calculateTotalPrice();
     orderUid = genRandomID(8);
@@ -11,7 +77,7 @@ Order::Order(const vector<MenuItem>& menuItems)
 Order::Order(const vector<MenuItem>& menuItems, const string& uid)
     : items(menuItems),
       orderUid(uid),
-      dateCreated(parseDate(getCurrentDate())),
+      dateCreated(getCurrentDateTime()),
       orderState(OrderState::PENDING) {
     totalPrice = calculateTotalPrice();
     orderUid = genRandomID(8);
@@ -112,23 +178,18 @@ optional<Order> getOrder(const string& orderUid) {
     double totalPrice = 0;
     double VAT = 0;
 
-    ifstream file("../storage/orders.csv");
+    ifstream file(ORDERS_FILE_PATH);
 
     assert(file.is_open());
 
     string line;
+    vector<string> row;
 
     // skip headers
     getline(file, line);
 
     while (getline(file, line)) {
-        stringstream lineSS(line);
-        string cell;
-        vector<string> row;
-
-        while (getline(lineSS, cell, ',')) {
-            row.push_back(cell);
-        }
+        splitRow(line, row);
 
         if (row.empty()) {
             continue;
@@ -140,26 +201,13 @@ optional<Order> getOrder(const string& orderUid) {
             continue;
         }
 
-        string itemId = row.at(1);
-        string itemName = row.at(3);
-        // todo: handle invalid value with try-catch
-        double basePrice = stod(row.at(4));
-        MenuItemSizes itemSize = fromString(row.at(5));
-        uint8_t itemQty = stoul(row.at(6));
-        optional<string> remarks =
-            row.at(10).empty() ? nullopt : optional(row.at(9));
-
         // if first time appending
         if (menuItems.empty()) {
-            orderState = orderStateFromString(row.at(10));
-            dateCreated = parseDate(row.at(2));
-            totalPrice = stod(row.at(8));
-            VAT = stod(row.at(9));
+            orderMetadataFromRow(row, dateCreated, orderState, totalPrice,
+                                 VAT);
         }
 
-        MenuItem item(itemId, itemName, basePrice, itemSize, itemQty, remarks);
-
-        menuItems.push_back(item);
+        menuItems.push_back(menuItemFromRow(row));
     }
 
     if (menuItems.empty()) {
@@ -172,13 +220,13 @@ optional<Order> getOrder(const string& orderUid) {
 }
 
 void saveOrder(const Order& order) {
-    if (!exists("../storage")) {
-        create_directories("../storage");
+    if (!exists(STORAGE_DIRECTORY)) {
+        create_directories(STORAGE_DIRECTORY);
     }
 
-    bool fileExists = exists("../storage/orders.csv");
+    bool fileExists = exists(ORDERS_FILE_PATH);
 
-    ofstream file("../storage/orders.csv", ios::app);
+    ofstream file(ORDERS_FILE_PATH, ios::app);
 
     assert(file.is_open());
 
@@ -191,7 +239,7 @@ void saveOrder(const Order& order) {
 
     for (auto& item : order.getItems()) {
         file << order.getOrderUid() << "," << item.getUid() << ","
-             << parseDate(order.createdAt()) << "," << item.getName() << ","
+             << parseDateTime(order.createdAt()) << "," << item.getName() << ","
              << formatDoublePrecision(item.getBasePrice()) << ","
              << toString(item.getSize()) << "," << formatNumber(item.getQty())
              << "," << formatDoublePrecision(item.calculateSubtotal()) << ","
@@ -206,4 +254,231 @@ void saveOrder(const Order& order) {
     }
 
     file.close();
+
+    for (const auto& subscriber : savedOrderSubscribers) {
+        subscriber(order);
+    }
+}
+
+void subscribeToSavedOrders(OrderSavedCallback cb) {
+    savedOrderSubscribers.push_back(cb);
+}
+
+size_t getOrderChunkCount(const string& path) {
+    // around 64KiB per thread at the very least
+    const uintmax_t minChunkSize = 1 << 16;
+
+    error_code ec;
+    uintmax_t size = file_size(path, ec);
+
+    if (ec) {
+        return 1;
+    }
+
+    size_t workers = max(thread::hardware_concurrency(), 1u);
+
+    return static_cast<size_t>(
+        min<uintmax_t>(workers, size / minChunkSize + 1));
+}
+
+vector<streamoff> splitOrdersIntoChunks(const string& path,
+                                        size_t chunkCount) {
+    assert(chunkCount > 0 || !"splitOrdersIntoChunks() needs >= 1 chunk");
+
+    error_code ec;
+    streamoff size = static_cast<streamoff>(file_size(path, ec));
+    vector<streamoff> offsets;
+    OrderReader reader(path);
+
+    offsets.push_back(reader.tell());
+
+    for (size_t i = 1; i < chunkCount && !ec; ++i) {
+        reader.seekToNextOrderFrom(size * static_cast<streamoff>(i) /
+                                   static_cast<streamoff>(chunkCount));
+        offsets.push_back(max(reader.tell(), offsets.back()));
+    }
+
+    offsets.push_back(numeric_limits<streamoff>::max());
+
+    return offsets;
+}
+
+void readOrderChunksInParallel(const string& path,
+                               const vector<streamoff>& offsets,
+                               OrderChunkCallback cb) {
+    assert(offsets.size() >= 2 ||
+           !"readOrderChunksInParallel() received no chunks");
+
+    auto readChunk = [&path, &offsets, &cb](size_t chunk) {
+        OrderReader reader(path);
+
+        if (!reader.isOpen()) {
+            return;
+        }
+
+        reader.seek(offsets.at(chunk));
+
+        while (reader.tell() < offsets.at(chunk + 1)) {
+            optional<Order> order = reader.next();
+
+            if (!order.has_value()) {
+                break;
+            }
+
+            cb(chunk, order.value());
+        }
+    };
+
+    vector<thread> workers;
+
+    for (size_t i = 1, l = offsets.size() - 1; i < l; ++i) {
+        workers.emplace_back(readChunk, i);
+    }
+
+    // the calling thread takes the first chunk
+    readChunk(0);
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+OrderReader::OrderReader() : OrderReader(ORDERS_FILE_PATH) {}
+
+OrderReader::OrderReader(const string& path)
+    : file(path, ios::binary),
+      offset(0),
+      firstRowOffset(0),
+      pendingRowOffset(0) {
+    if (!file.is_open()) {
+        return;
+    }
+
+    string line;
+
+    // skip headers
+    if (getline(file, line)) {
+        offset = static_cast<streamoff>(line.size()) + 1;
+        firstRowOffset = offset;
+    }
+}
+
+bool OrderReader::isOpen() const noexcept { return file.is_open(); }
+
+bool OrderReader::readRow(vector<string>& row, streamoff& rowOffset) {
+    string line;
+
+    while (getline(file, line)) {
+        rowOffset = offset;
+        offset += static_cast<streamoff>(line.size()) + 1;
+
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        if (dateFilter.has_value() &&
+            !rowCreatedOn(line, dateFilter.value())) {
+            continue;
+        }
+
+        splitRow(line, row);
+
+        if (!row.empty()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+optional<Order> OrderReader::next() {
+    if (!file.is_open()) {
+        return nullopt;
+    }
+
+    vector<string> row;
+    streamoff rowOffset = 0;
+
+    if (!pendingRow.empty()) {
+        row = move(pendingRow);
+        pendingRow.clear();
+    } else if (!readRow(row, rowOffset)) {
+        return nullopt;
+    }
+
+    const string orderUid = row.at(0);
+    vector<MenuItem> menuItems;
+    OrderState orderState = OrderState::PENDING;
+    tm dateCreated = {};
+    double totalPrice = 0;
+    double VAT = 0;
+
+    orderMetadataFromRow(row, dateCreated, orderState, totalPrice, VAT);
+    menuItems.push_back(menuItemFromRow(row));
+
+    while (readRow(row, rowOffset)) {
+        if (row.at(0) != orderUid) {
+            pendingRow = move(row);
+            pendingRowOffset = rowOffset;
+
+            break;
+        }
+
+        menuItems.push_back(menuItemFromRow(row));
+    }
+
+    return Order(menuItems, orderUid, dateCreated, orderState, totalPrice,
+                 VAT);
+}
+
+streamoff OrderReader::tell() const noexcept {
+    return pendingRow.empty() ? offset : pendingRowOffset;
+}
+
+void OrderReader::seek(streamoff off) {
+    assert(file.is_open() || !"OrderReader::seek() called on a closed file");
+
+    file.clear();
+    file.seekg(off);
+
+    offset = off;
+    pendingRow.clear();
+}
+
+void OrderReader::filterByDate(const tm& date) { dateFilter = parseDate(date); }
+
+void OrderReader::seekToNextOrderFrom(streamoff off) {
+    if (off <= firstRowOffset) {
+        seek(firstRowOffset);
+
+        return;
+    }
+
+    seek(off);
+
+    string partialLine;
+
+    if (!getline(file, partialLine)) {
+        return;
+    }
+
+    offset += static_cast<streamoff>(partialLine.size()) + 1;
+
+    vector<string> row;
+    streamoff rowOffset = 0;
+
+    if (!readRow(row, rowOffset)) {
+        return;
+    }
+
+    const string orderUid = row.at(0);
+
+    while (readRow(row, rowOffset)) {
+        if (row.at(0) != orderUid) {
+            pendingRow = move(row);
+            pendingRowOffset = rowOffset;
+
+            return;
+        }
+    }
 }
@@ -47,6 +47,13 @@ string getCurrentDate() {
     return dateStream.str();
 }
 
+tm getCurrentDateTime() {
+    auto now = system_clock::now();
+    auto time_t_now = system_clock::to_time_t(now);
+
+    return *localtime(&time_t_now);
+}
+
 string parseDate(const tm& date) {
     ostringstream dateStream;
 
@@ -67,3 +74,101 @@ tm parseDate(const string& dateString) {
 
     return time;
 }
+
+string parseDateTime(const tm& date) {
+    ostringstream dateStream;
+
+    dateStream << put_time(&date, "%Y-%m-%d %H:%M:%S");
+
+    assert(!dateStream.fail());
+
+    return dateStream.str();
+}
+
+tm parseDateTime(const string& dateString) {
+    tm time = {};
+    istringstream ss(dateString);
+
+    ss >> get_time(&time, "%Y-%m-%d");
+
+    assert(!ss.fail());
+
+    // date-only strings end here
+    if (ss.peek() != ' ') {
+        return time;
+    }
+
+    tm timeOfDay = {};
+
+    ss >> get_time(&timeOfDay, " %H:%M:%S");
+
+    if (!ss.fail()) {
+        time.tm_hour = timeOfDay.tm_hour;
+        time.tm_min = timeOfDay.tm_min;
+        time.tm_sec = timeOfDay.tm_sec;
+    }
+
+    return time;
+}
+
+// Howard Hinnant's days_from_civil
+long daysSinceEpoch(const tm& date) noexcept {
+    long y = date.tm_year + 1900;
+    long m = date.tm_mon + 1;
+    long d = date.tm_mday;
+
+    y -= m <= 2;
+
+    long era = (y >= 0 ? y : y - 399) / 400;
+    long yoe = y - era * 400;
+    long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + doe - 719468;
+}
+
+// Howard Hinnant's civil_from_days
+tm dateFromDaysSinceEpoch(long days) noexcept {
+    days += 719468;
+
+    long era = (days >= 0 ? days : days - 146096) / 146097;
+    long doe = days - era * 146097;
+    long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long mp = (5 * doy + 2) / 153;
+    long d = doy - (153 * mp + 2) / 5 + 1;
+    long m = mp + (mp < 10 ? 3 : -9);
+    long y = yoe + era * 400 + (m <= 2);
+    tm date = {};
+
+    date.tm_year = static_cast<int>(y - 1900);
+    date.tm_mon = static_cast<int>(m - 1);
+    date.tm_mday = static_cast<int>(d);
+    date.tm_wday = static_cast<int>(weekdayOfEpochDay(days - 719468));
+
+    return date;
+}
+
+unsigned int weekdayOfEpochDay(long days) noexcept {
+    // 1970-01-01 is a Thursday
+    long weekday = (days + 4) % 7;
+
+    return static_cast<unsigned int>(weekday < 0 ? weekday + 7 : weekday);
+}
+
+long weekOfEpochDay(long days) noexcept {
+    long shifted = days + 4;
+
+    return shifted >= 0 ? shifted / 7 : (shifted - 6) / 7;
+}
+
+size_t hourOfWeek(long hoursSinceEpoch) noexcept {
+    long day = hoursSinceEpoch / 24;
+
+    if (hoursSinceEpoch % 24 < 0) {
+        --day;
+    }
+
+    return weekdayOfEpochDay(day) * 24 +
+           static_cast<size_t>(hoursSinceEpoch - day * 24);
+}
@@ -1,3 +1,10 @@
+#include <ast/layout.hpp>
+#include <ast/pool.hpp>
+#include <ast/style.hpp>
+#include <contrib/affinity.hpp>
+#include <contrib/cube.hpp>
+#include <contrib/forecast.hpp>
+#include <contrib/grading.hpp>
 #include <contrib/state.hpp>
 #include <iostream>
 #include <keyboard.hpp>
@@ -24,19 +31,26 @@ int main() {
     disableTextWrapping();
 
     try {
+        initializeDemandForecaster();
         initializeState();
+        initializeSalesGrader();
+        initializeBasketAffinity();
+        initializeSalesCube();
         initializeScreen();
+        initializeLayoutStore();
+        initializeNodePools();
+        initializeTextStyleTable();
         initializeRenderer();
 
         Screen& screen = getScreen();
 
-        screen.subscribe(onScreenSizeChange);
+        Connection screenSizeChange = screen.subscribe(onScreenSizeChange);
         getRenderer().renderBuffer();
 
         LoopLambda loop(100, programEntryPoint);
 
         loop.start();
-        screen.unsubscribe(onScreenSizeChange);
+        screen.unsubscribe(screenSizeChange);
     } catch (const exception& e) {
         gracefulError(e);
     }
@@ -12,242 +12,382 @@ void initializeRenderer() {
     renderer->createView();
 }
 
-Renderer::Renderer() : viewState(RendererState::MENU) {}
-
-void Renderer::createView() {
-    bool isNew = true;
-
-    // if exists, remove
-    if (rootNode) {
-        moveCursorTo(static_cast<unsigned int>(0), rootNode->getHeight());
-        clearLinesFromCursorToEndOfLine(rootNode->getHeight());
+static string basePriceText(const MenuItemData& item) {
+    return "Base price: ₱" + formatNumber(item.getBasePrice());
+}
 
-        rootNode.reset();
-        header.reset();
-        body.reset();
-        footer.reset();
+static string additionalPriceText(const MenuItemSizeData& item) {
+    return "Additional price: ₱" + formatNumber(item.getAdditionalPrice());
+}
 
-        isNew = false;
-    }
+// TODO: Add add-ons to subtotal
+static string subtotalText(const MenuItem* item) {
+    return "Base price: ₱" + formatNumber(item->getBasePrice()) +
+           ", Subtotal: ₱" + formatNumber(item->calculateSubtotal());
+}
 
-    rootNode = make_shared<ContainerNode>();
-    header = make_shared<ContainerNode>();
-    body = make_shared<ContainerNode>();
-    footer = make_shared<ContainerNode>();
+static string qtyText(const MenuItem* item) {
+    return "- " + formatNumber(item->getQty()) + " +";
+}
 
-    auto title = make_shared<TextNode>(TITLE.data());
+Renderer::Renderer()
+    : isDispatchingKey(false),
+      keepsDispatchedView(false),
+      rootNode(nullptr),
+      viewWidth(0),
+      header(nullptr),
+      body(nullptr),
+      footer(nullptr),
+      viewState(RendererState::MENU) {}
 
-    title->setWidth(getScreen().getWidth());
-    title->setColor(255, 255, 0);
-    title->setBold();
+void Renderer::createView() {
+    bool isNew = rootNode == nullptr;
 
-    auto titleBr = make_shared<LineBreakNode>(2);
+    ContainerNode* describedRoot = nodeArena.make<ContainerNode>();
 
-    header->appendChild(title);
-    header->appendChild(titleBr);
+    header = nodeArena.make<ContainerNode>();
+    body = nodeArena.make<ContainerNode>();
+    footer = nodeArena.make<ContainerNode>();
 
     switch (viewState) {
         case RendererState::MENU: {
-            createMenuHeader(isNew);
+            createCachedChrome(HEADER_CHROME, &Renderer::createMenuHeader);
             createMenuView(isNew);
-            createMenuFooter(isNew);
+            createCachedChrome(FOOTER_CHROME, &Renderer::createMenuFooter);
         }; break;
         case RendererState::MENU_ITEM: {
-            createMenuItemHeader(isNew);
+            createCachedChrome(HEADER_CHROME, &Renderer::createMenuItemHeader);
             createMenuItemView(isNew);
-            createMenuItemFooter(isNew);
+            createCachedChrome(FOOTER_CHROME, &Renderer::createMenuItemFooter);
         }; break;
         case RendererState::MENU_ITEM_CONFIRM: {
-            createMenuItemConfirmHeader(isNew);
+            createCachedChrome(HEADER_CHROME,
+                               &Renderer::createMenuItemConfirmHeader);
             createMenuItemConfirmView(isNew);
-            createMenuItemConfirmFooter(isNew);
+            createCachedChrome(FOOTER_CHROME,
+                               &Renderer::createMenuItemConfirmFooter);
         }; break;
         case RendererState::MENU_ITEM_SIZES: {
-            createMenuItemSizesHeader(isNew);
+            createCachedChrome(HEADER_CHROME,
+                               &Renderer::createMenuItemSizesHeader);
             createMenuItemSizesView(isNew);
-            createMenuItemSizesFooter(isNew);
+            createCachedChrome(FOOTER_CHROME,
+                               &Renderer::createMenuItemSizesFooter);
         }; break;
         case RendererState::MENU_ITEM_ADDONS: {
-            createMenuItemAddonsHeader(isNew);
+            createCachedChrome(HEADER_CHROME,
+                               &Renderer::createMenuItemAddonsHeader);
             createMenuItemAddonsView(isNew);
-            createMenuItemAddonsFooter(isNew);
+            createCachedChrome(FOOTER_CHROME,
+                               &Renderer::createMenuItemAddonsFooter);
         }; break;
         case RendererState::ORDER_CONFIRMATION: {
-            createOrderConfirmationHeader(isNew);
+            createCachedChrome(HEADER_CHROME,
+                               &Renderer::createOrderConfirmationHeader);
             createOrderConfirmationView(isNew);
+            // its buttons depend on whether the cart is empty
             createOrderConfirmationFooter(isNew);
         }; break;
         case RendererState::ORDER_RESULTS: {
+            // it shows the ID of the order
+            createTitle();
             createOrderResultsHeader(isNew);
             createOrderResultsView(isNew);
-            createOrderResultsFooter(isNew);
+            createCachedChrome(FOOTER_CHROME,
+                               &Renderer::createOrderResultsFooter);
         }; break;
         case RendererState::ADMIN_MENU: {
-            createAdminMenuHeader(isNew);
+            createCachedChrome(HEADER_CHROME, &Renderer::createAdminMenuHeader);
             createAdminMenuView(isNew);
-            createAdminMenuFooter(isNew);
+            createCachedChrome(FOOTER_CHROME, &Renderer::createAdminMenuFooter);
         }; break;
     }
 
-    shared_ptr<LineBreakNode> headerBr = make_shared<LineBreakNode>(2);
-    shared_ptr<LineBreakNode> bodyBr = make_shared<LineBreakNode>(3);
+    LineBreakNode* headerBr = nodeArena.make<LineBreakNode>(2);
+    LineBreakNode* bodyBr = nodeArena.make<LineBreakNode>(3);
 
-    rootNode->appendChild(header);
-    rootNode->appendChild(headerBr);
-    rootNode->appendChild(body);
-    rootNode->appendChild(bodyBr);
-    rootNode->appendChild(footer);
+    describedRoot->appendChild(header);
+    describedRoot->appendChild(headerBr);
+    describedRoot->appendChild(body);
+    describedRoot->appendChild(bodyBr);
+    describedRoot->appendChild(footer);
 
-    rootNode->render(&buf);
-}
+    header = nullptr;
+    body = nullptr;
+    footer = nullptr;
 
-void Renderer::createMenuHeader(bool isNew) {
-    Screen& screen = getScreen();
-    State& state = getState();
-    shared_ptr<GridNode> navHeader =
-        make_shared<GridNode>(screen.getWidth(), 0, 2, 1);
+    // the chrome cached for the old width was made again, and the
+    // retained view still points at it, so it can't be patched
+    bool isResized = viewWidth != getScreen().getWidth();
 
-    navHeader->setIsFlexible(false);
+    // only props changed, so the nodes on screen are patched
+    // and the description is thrown away
+    if (!isNew && !isResized && reconcile(rootNode, describedRoot)) {
+        nodeArena.reset();
+        bindKeys();
+        updateView();
+
+        return;
+    }
 
-    shared_ptr<ButtonNode> shopBtn =
-        make_shared<ButtonNode>("s", "shop", make_tuple(KEY_s, KEY_S), true);
-    shared_ptr<ButtonNode> adminBtn =
-        make_shared<ButtonNode>("a", "admin", make_tuple(KEY_a, KEY_A));
-    shared_ptr<ButtonNode> checkoutBtn =
-        make_shared<ButtonNode>("c", "checkout", make_tuple(KEY_c, KEY_C));
+    // if exists, remove
+    if (rootNode) {
+        moveCursorTo(static_cast<unsigned int>(0), rootNode->getHeight());
+        clearLinesFromCursorToEndOfLine(rootNode->getHeight());
+    }
 
-    shopBtn->subscribe(onShopBtnClicked);
-    adminBtn->subscribe(onAdminBtnClicked);
-    checkoutBtn->subscribe(onCheckoutBtnClicked);
+    // the tree a key is being dispatched to has to outlive the
+    // dispatch, the one built by an earlier handler doesn't
+    if (isDispatchingKey && !keepsDispatchedView) {
+        retainedNodeArena.swap(dispatchedNodeArena);
+        keepsDispatchedView = true;
+    }
 
-    navHeader->appendChild(shopBtn);
-    navHeader->appendChild(adminBtn);
-    navHeader->appendChild(checkoutBtn);
+    retainedNodeArena.reset();
+    retainedNodeArena.swap(nodeArena);
 
-    header->appendChild(navHeader);
+    rootNode = describedRoot;
+    viewWidth = getScreen().getWidth();
+
+    bindKeys();
+    updateView();
 }
 
-void Renderer::createMenuItemHeader(bool isNew) {
-    Screen& screen = getScreen();
-    State& state = getState();
-    shared_ptr<GridNode> navHeader =
-        make_shared<GridNode>(screen.getWidth(), 0);
+void Renderer::createTitle() {
+    TextNode* title = nodeArena.make<TextNode>(TITLE.data());
 
-    navHeader->setIsFlexible(false);
-    navHeader->setColGap(2);
-    navHeader->setRowGap(1);
+    title->setWidth(getScreen().getWidth());
+    title->setColor(255, 255, 0);
+    title->setBold();
 
-    shared_ptr<ButtonNode> backBtn =
-        make_shared<ButtonNode>("←(esc)", "BACK", make_tuple(KEY_ESC, KEY_ESC));
-    shared_ptr<ButtonNode> sizesBtn =
-        make_shared<ButtonNode>("s", "SIZES", make_tuple(KEY_S, KEY_s));
-    shared_ptr<ButtonNode> addonsBtn =
-        make_shared<ButtonNode>("a", "ADD-ONS", make_tuple(KEY_A, KEY_a));
+    header->appendChild(title);
+    header->appendChild(nodeArena.make<LineBreakNode>(2));
+}
 
-    backBtn->subscribe(onEscBtnClickedOnMenuItem);
-    sizesBtn->subscribe(onSizesBtnClicked);
-    addonsBtn->subscribe(onAddonsBtnClicked);
+void Renderer::createCachedChrome(ChromeSection section,
+                                  void (Renderer::*create)(bool)) {
+    unsigned int screenWidth = getScreen().getWidth();
+    unique_ptr<CachedChrome>& cached = chromeCache[viewState][section];
+    ContainerNode*& container = section == HEADER_CHROME ? header : footer;
 
-    navHeader->appendChild(backBtn);
-    navHeader->appendChild(sizesBtn);
-    navHeader->appendChild(addonsBtn);
+    if (!cached) {
+        cached = make_unique<CachedChrome>();
+    }
 
-    header->appendChild(navHeader);
-}
+    // keys are never dispatched to the nodes of an entry while it
+    // is made again, as the width only changes between key presses
+    if (!cached->snapshot.has_value() || cached->screenWidth != screenWidth) {
+        ContainerNode* describedContainer = container;
 
-void Renderer::createMenuItemConfirmHeader(bool isNew) {
-    Screen& screen = getScreen();
-    State& state = getState();
-    shared_ptr<GridNode> navHeader =
-        make_shared<GridNode>(screen.getWidth(), 0);
+        cached->snapshot.reset();
+        cached->nodeArena.reset();
 
-    navHeader->setIsFlexible(false);
-    navHeader->setColGap(2);
-    navHeader->setRowGap(1);
+        // the create methods make their nodes in `nodeArena` and
+        // append them to `header` or `footer`, so those are the
+        // entry's while it is made
+        nodeArena.swap(cached->nodeArena);
+        container = nodeArena.make<ContainerNode>();
 
-    shared_ptr<ButtonNode> backBtn =
-        make_shared<ButtonNode>("←(esc)", "BACK", make_tuple(KEY_ESC, KEY_ESC));
+        if (section == HEADER_CHROME) {
+            createTitle();
+        }
 
-    backBtn->subscribe(onEscBtnClickedOnMenuItem);
+        (this->*create)(true);
 
-    navHeader->appendChild(backBtn);
+        ContainerNode* chrome = container;
 
-    header->appendChild(navHeader);
-}
+        container = describedContainer;
+        nodeArena.swap(cached->nodeArena);
 
-void Renderer::createMenuItemSizesHeader(bool isNew) {
-	Screen& screen = getScreen();
-	State& state = getState();
-	shared_ptr<GridNode> navHeader = make_shared<GridNode>(screen.getWidth(), 0);
+        chrome->layout(screenWidth);
+        cached->snapshot.emplace(chrome);
+        cached->screenWidth = screenWidth;
+    }
 
-    navHeader->setIsFlexible(false);
-    navHeader->setColGap(2);
-    navHeader->setRowGap(1);
+    container->appendChild(
+        nodeArena.make<SnapshotNode>(&cached->snapshot.value()));
+}
 
-    shared_ptr<ButtonNode> backBtn =
-        make_shared<ButtonNode>("←(esc)", "BACK", make_tuple(KEY_ESC, KEY_ESC));
-    shared_ptr<ButtonNode> sizesBtn =
-        make_shared<ButtonNode>("s", "SIZES", make_tuple(KEY_S, KEY_s), true);
-    shared_ptr<ButtonNode> addonsBtn =
-        make_shared<ButtonNode>("a", "ADD-ONS", make_tuple(KEY_A, KEY_a));
+void Renderer::bindKeys() {
+    keyBindings.clear();
 
-    backBtn->subscribe(onEscBtnClickedOnMenuItem);
-    addonsBtn->subscribe(onAddonsBtnClicked);
+    FocusScopeId bodyScope = keyBindings.openScope(ROOT_FOCUS_SCOPE);
+    // the view is the header, a line break, the body, another
+    // line break and the footer
+    Node::NodePtr viewBody = rootNode->getChildAt(2);
 
-    navHeader->appendChild(backBtn);
-    navHeader->appendChild(sizesBtn);
-    navHeader->appendChild(addonsBtn);
+    for (Node::NodePtr c = rootNode->getFirstChild(); c != nullptr;
+         c = c->getNextSibling()) {
+        keyBindings.bindTree(c, c == viewBody ? bodyScope : ROOT_FOCUS_SCOPE);
+    }
 
-    header->appendChild(navHeader);
+    keyBindings.focus(bodyScope);
 }
 
-void Renderer::createMenuItemAddonsHeader(bool isNew) {
-    Screen& screen = getScreen();
-    State& state = getState();
-    shared_ptr<GridNode> navHeader =
-        make_shared<GridNode>(screen.getWidth(), 0);
+void Renderer::updateView() {
+    rootNode->layout(getScreen().getWidth());
+    rootNode->paint(&buf);
+}
 
-    navHeader->setIsFlexible(false);
-    navHeader->setColGap(2);
-    navHeader->setRowGap(1);
+/**
+ *
+ * Rows the title, header, footer, line breaks and anything else
+ * around the scrolling list or table of a view take
+ */
+const unsigned int MENU_CHROME_ROWS = 12;
+const unsigned int ORDER_CONFIRMATION_CHROME_ROWS = 19;
+const unsigned int ORDER_RESULTS_CHROME_ROWS = 15;
+
+/**
+ *
+ * Rows of a list or table that fit the screen next to
+ * `chromeRows` rows of everything else
+ */
+static unsigned int rowsLeftOnScreen(unsigned int chromeRows) {
+    unsigned int screenHeight = getScreen().getHeight();
+
+    return screenHeight > chromeRows ? screenHeight - chromeRows : 1;
+}
 
-    shared_ptr<ButtonNode> backBtn =
-        make_shared<ButtonNode>("←(esc)", "BACK", make_tuple(KEY_ESC, KEY_ESC));
-    shared_ptr<ButtonNode> sizesBtn =
-        make_shared<ButtonNode>("s", "SIZES", make_tuple(KEY_S, KEY_s));
-    shared_ptr<ButtonNode> addonsBtn =
-        make_shared<ButtonNode>("a", "ADD-ONS", make_tuple(KEY_A, KEY_a), true);
+/**
+ *
+ * Menu item shown at `row` of the ranked menu
+ */
+static const MenuItemData& menuItemAtRow(const vector<size_t>& rankedItemIds,
+                                         size_t row) {
+    return getState().getMenuItemsData().at(rankedItemIds.at(row));
+}
 
-    backBtn->subscribe(onEscBtnClickedOnMenuItem);
-    sizesBtn->subscribe(onSizesBtnClicked);
+/**
+ *
+ * Buttons of the headers and footers, which don't change
+ * with the state, so they are described here once
+ */
+constexpr ButtonSpec BACK_NAV_BUTTON = {
+    "←(esc)", "BACK", {KEY_ESC, KEY_ESC}, onEscBtnClickedOnMenuItem, false};
+constexpr ButtonSpec QUIT_TOOL_TIP = {"q", "quit", {0, 0}, nullptr, true};
+
+constexpr ButtonSpec MENU_NAV_BUTTONS[] = {
+    {"s", "shop", {KEY_s, KEY_S}, onShopBtnClicked, true},
+    {"a", "admin", {KEY_a, KEY_A}, onAdminBtnClicked, false},
+    {"c", "checkout", {KEY_c, KEY_C}, onCheckoutBtnClicked, false},
+};
+constexpr ButtonSpec MENU_ITEM_NAV_BUTTONS[] = {
+    BACK_NAV_BUTTON,
+    {"s", "SIZES", {KEY_S, KEY_s}, onSizesBtnClicked, false},
+    {"a", "ADD-ONS", {KEY_A, KEY_a}, onAddonsBtnClicked, false},
+};
+constexpr ButtonSpec MENU_ITEM_CONFIRM_NAV_BUTTONS[] = {BACK_NAV_BUTTON};
+constexpr ButtonSpec MENU_ITEM_SIZES_NAV_BUTTONS[] = {
+    BACK_NAV_BUTTON,
+    {"s", "SIZES", {KEY_S, KEY_s}, nullptr, true},
+    {"a", "ADD-ONS", {KEY_A, KEY_a}, onAddonsBtnClicked, false},
+};
+constexpr ButtonSpec MENU_ITEM_ADDONS_NAV_BUTTONS[] = {
+    BACK_NAV_BUTTON,
+    {"s", "SIZES", {KEY_S, KEY_s}, onSizesBtnClicked, false},
+    {"a", "ADD-ONS", {KEY_A, KEY_a}, nullptr, true},
+};
+constexpr ButtonSpec ORDER_CONFIRMATION_NAV_BUTTONS[] = {
+    {"s", "shop", {KEY_S, KEY_s}, onShopBtnClicked, false},
+    {"c", "checkout", {KEY_c, KEY_C}, onCheckoutBtnClicked, true},
+};
+constexpr ButtonSpec ADMIN_MENU_NAV_BUTTONS[] = {
+    {"s", "shop", {KEY_s, KEY_S}, onShopBtnClicked, false},
+    {"a", "admin", {KEY_a, KEY_A}, onAdminBtnClicked, true},
+};
+
+/** Of the menu and the sizes of a menu item */
+constexpr ButtonSpec LIST_TOOL_TIPS[] = {
+    {"\u23CE", "enter", {KEY_ENTER, KEY_ENTER_LINUX},
+     onEnterBtnClickedMenuSelect, true},
+    {"↑/↓", "up/down", {0, 0}, nullptr, true},
+    QUIT_TOOL_TIP,
+};
+constexpr ButtonSpec MENU_ITEM_TOOL_TIPS[] = {
+    {"\u23CE", "enter", {KEY_ENTER, KEY_ENTER_LINUX},
+     onEnterBtnClickedMenuSelect, true},
+    {"-/+", "add/minus", {KEY_HYPHEN_MINUS, KEY_PLUS}, onAddMinusBtnClicked,
+     true},
+    QUIT_TOOL_TIP,
+};
+constexpr ButtonSpec MENU_ITEM_CONFIRM_TOOL_TIPS[] = {
+    {"\u23CE(enter)", "confirm", {KEY_ENTER, KEY_ENTER_LINUX},
+     onEnterBtnClickedMenuSelect, true},
+    QUIT_TOOL_TIP,
+};
+constexpr ButtonSpec QUIT_TOOL_TIPS[] = {QUIT_TOOL_TIP};
+constexpr ButtonSpec ORDER_CONFIRMATION_TOOL_TIPS[] = {
+    {"←(esc)", "clear", {KEY_ESC, KEY_ESC}, onEscBtnClickedOnMenuItem, true},
+    {"\u23CE(enter)", "confirm", {KEY_ENTER, KEY_ENTER_LINUX},
+     onEnterBtnClickedMenuSelect, true},
+    QUIT_TOOL_TIP,
+};
+constexpr ButtonSpec ORDER_RESULTS_TOOL_TIPS[] = {
+    {"←(esc)", "BACK", {KEY_ESC, KEY_ESC}, onEscBtnClickedOnMenuItem, true},
+    QUIT_TOOL_TIP,
+};
+constexpr ButtonSpec ADMIN_MENU_TOOL_TIPS[] = {
+    {"z", "z-report", {KEY_z, KEY_Z}, onZReportBtnClicked, false},
+    QUIT_TOOL_TIP,
+};
+
+constexpr ButtonBarSpec MENU_NAV = buttonBar(2, 1, MENU_NAV_BUTTONS);
+constexpr ButtonBarSpec MENU_ITEM_NAV = buttonBar(2, 1, MENU_ITEM_NAV_BUTTONS);
+constexpr ButtonBarSpec MENU_ITEM_CONFIRM_NAV =
+    buttonBar(2, 1, MENU_ITEM_CONFIRM_NAV_BUTTONS);
+constexpr ButtonBarSpec MENU_ITEM_SIZES_NAV =
+    buttonBar(2, 1, MENU_ITEM_SIZES_NAV_BUTTONS);
+constexpr ButtonBarSpec MENU_ITEM_ADDONS_NAV =
+    buttonBar(2, 1, MENU_ITEM_ADDONS_NAV_BUTTONS);
+constexpr ButtonBarSpec ORDER_CONFIRMATION_NAV =
+    buttonBar(2, 2, ORDER_CONFIRMATION_NAV_BUTTONS);
+constexpr ButtonBarSpec ADMIN_MENU_NAV =
+    buttonBar(2, 2, ADMIN_MENU_NAV_BUTTONS);
+
+constexpr ButtonBarSpec LIST_FOOTER = buttonBar(2, 1, LIST_TOOL_TIPS);
+constexpr ButtonBarSpec MENU_ITEM_FOOTER = buttonBar(2, 1, MENU_ITEM_TOOL_TIPS);
+constexpr ButtonBarSpec MENU_ITEM_CONFIRM_FOOTER =
+    buttonBar(2, 1, MENU_ITEM_CONFIRM_TOOL_TIPS);
+constexpr ButtonBarSpec QUIT_FOOTER = buttonBar(2, 1, QUIT_TOOL_TIPS);
+constexpr ButtonBarSpec ORDER_CONFIRMATION_FOOTER =
+    buttonBar(2, 1, ORDER_CONFIRMATION_TOOL_TIPS);
+constexpr ButtonBarSpec ORDER_RESULTS_FOOTER =
+    buttonBar(2, 1, ORDER_RESULTS_TOOL_TIPS);
+constexpr ButtonBarSpec ADMIN_MENU_FOOTER =
+    buttonBar(2, 1, ADMIN_MENU_TOOL_TIPS);
+
+void Renderer::createNav(const ButtonBarSpec& spec) {
+    header->appendChild(
+        makeButtonBar(nodeArena, spec, getScreen().getWidth()));
+}
 
-    navHeader->appendChild(backBtn);
-    navHeader->appendChild(sizesBtn);
-    navHeader->appendChild(addonsBtn);
+void Renderer::createToolTips(const ButtonBarSpec& spec) {
+    unsigned int screenWidth = getScreen().getWidth();
 
-    header->appendChild(navHeader);
+    footer->appendChild(nodeArena.make<TextNode>(string(screenWidth, '-')));
+    footer->appendChild(makeButtonBar(nodeArena, spec, screenWidth));
+    footer->appendChild(nodeArena.make<TextNode>(string(screenWidth, '-')));
 }
 
-void Renderer::createOrderConfirmationHeader(bool isNew) {
-    Screen& screen = getScreen();
-    State& state = getState();
-    shared_ptr<GridNode> navHeader =
-        make_shared<GridNode>(screen.getWidth(), 0, 2);
+void Renderer::createMenuHeader(bool isNew) { createNav(MENU_NAV); }
 
-    navHeader->setIsFlexible(false);
+void Renderer::createMenuItemHeader(bool isNew) { createNav(MENU_ITEM_NAV); }
 
-    shared_ptr<ButtonNode> shopBtn =
-        make_shared<ButtonNode>("s", "shop", make_tuple(KEY_S, KEY_s));
-    shared_ptr<ButtonNode> checkoutBtn = make_shared<ButtonNode>(
-        "c", "checkout", make_tuple(KEY_c, KEY_C), true);
+void Renderer::createMenuItemConfirmHeader(bool isNew) {
+    createNav(MENU_ITEM_CONFIRM_NAV);
+}
 
-    shopBtn->subscribe(onShopBtnClicked);
-    checkoutBtn->subscribe(onCheckoutBtnClicked);
+void Renderer::createMenuItemSizesHeader(bool isNew) {
+    createNav(MENU_ITEM_SIZES_NAV);
+}
 
-    navHeader->appendChild(shopBtn);
-    navHeader->appendChild(checkoutBtn);
+void Renderer::createMenuItemAddonsHeader(bool isNew) {
+    createNav(MENU_ITEM_ADDONS_NAV);
+}
 
-    header->appendChild(navHeader);
+void Renderer::createOrderConfirmationHeader(bool isNew) {
+    createNav(ORDER_CONFIRMATION_NAV);
 }
 
 void Renderer::createOrderResultsHeader(bool isNew) {
@@ -259,12 +399,12 @@ void Renderer::createOrderResultsHeader(bool isNew) {
 
     Order order = maybeOrder.value();
 
-    shared_ptr<GridNode> navHeader =
-        make_shared<GridNode>(screen.getWidth(), 0, 2);
+    GridNode* navHeader =
+        nodeArena.make<GridNode>(screen.getWidth(), 0, 2);
 
     navHeader->setIsFlexible(false);
 
-    shared_ptr<TextNode> thankYouText = make_shared<TextNode>(
+    TextNode* thankYouText = nodeArena.make<TextNode>(
         "The order has been confirmed. Its ID is " + order.getOrderUid());
 
     navHeader->appendChild(thankYouText);
@@ -272,70 +412,75 @@ void Renderer::createOrderResultsHeader(bool isNew) {
     header->appendChild(navHeader);
 }
 
-void Renderer::createAdminMenuHeader(bool isNew) {
-    Screen& screen = getScreen();
+void Renderer::createAdminMenuHeader(bool isNew) { createNav(ADMIN_MENU_NAV); }
+
+void Renderer::createMenuView(bool isNew) {
     State& state = getState();
-    shared_ptr<GridNode> navHeader =
-        make_shared<GridNode>(screen.getWidth(), 0, 2);
+    GridNode* menuGrid = nodeArena.make<GridNode>();
 
-    navHeader->setIsFlexible(false);
+    menuGrid->setIsFlexible(true);
 
-    shared_ptr<ButtonNode> shopBtn =
-        make_shared<ButtonNode>("s", "shop", make_tuple(KEY_s, KEY_S));
-    shared_ptr<ButtonNode> adminBtn =
-        make_shared<ButtonNode>("a", "admin", make_tuple(KEY_a, KEY_A), true);
+    const vector<MenuItemData>& menuItemsData = state.getMenuItemsData();
+    vector<string> cartItemNames;
 
-    shopBtn->subscribe(onShopBtnClicked);
-    adminBtn->subscribe(onAdminBtnClicked);
+    for (const auto& item : state.getMenuItemsInCart()) {
+        cartItemNames.push_back(item.getName());
+    }
 
-    navHeader->appendChild(shopBtn);
-    navHeader->appendChild(adminBtn);
+    // items often bought with what's in the cart come first
+    rankedMenuItemIds = getBasketAffinity().rankByAffinity(cartItemNames);
 
-    header->appendChild(navHeader);
-}
+    const vector<size_t>& rankedItemIds = rankedMenuItemIds;
 
-void Renderer::createMenuView(bool isNew) {
-    State& state = getState();
-    shared_ptr<GridNode> menuGrid = make_shared<GridNode>();
-    shared_ptr<SelectNode> menuSelect = make_shared<SelectNode>();
+    assert(rankedItemIds.size() == menuItemsData.size() ||
+           !"BasketAffinity was built with a different menu");
 
-    menuGrid->setIsFlexible(true);
+    // only the rows in view are pulled, so a long menu costs
+    // no more to scroll than a short one
+    VirtualListNode* menuList = nodeArena.make<VirtualListNode>(
+        rankedItemIds.size(),
+        [this](size_t row) {
+            return kebabToPascal(
+                menuItemAtRow(rankedMenuItemIds, row).getName());
+        },
+        rowsLeftOnScreen(MENU_CHROME_ROWS));
 
-    for (const auto item : state.getMenuItemsData()) {
-        shared_ptr<SelectOptionNode> optionNode =
-            make_shared<SelectOptionNode>(item.getName());
+    if (!isNew) {
+        const string& selectedName = state.getSelectedMenuItemDataName();
+        size_t row = 0;
 
-        menuSelect->appendChild(optionNode);
-    }
+        while (row < rankedItemIds.size() &&
+               menuItemAtRow(rankedItemIds, row).getName() != selectedName) {
+            ++row;
+        }
 
-    if (!isNew) {
-        menuSelect->setActiveChildWithValue(
-            state.getSelectedMenuItemDataName());
+        assert(row < rankedItemIds.size() ||
+               !"The selected menu item isn't on the menu");
+
+        menuList->setActiveRowIdx(row);
     } else {
         state.setSelectedMenuItemDataName(
-            state.getMenuItemsData()
-                .at(menuSelect->getActiveOptionIdx())
-                .getName());
+            menuItemAtRow(rankedItemIds, 0).getName());
     }
 
     optional<MenuItemData> maybeItem = state.getMenuItemDataWithName(
-        menuSelect->getValueOfSelectedOption().value());
+        menuItemAtRow(rankedItemIds, menuList->getActiveRowIdx()).getName());
 
     assert(
         maybeItem != nullopt ||
         !"Received nothing from State::getMenuItemWithId() where it shouldn't!");
 
-    shared_ptr<ContainerNode> activeMenuItemNode = make_shared<ContainerNode>();
-
-    menuSelect->subscribe(onMenuSelectUpdated);
+    menuList->subscribe([this](size_t row) {
+        onMenuSelectUpdated(menuItemAtRow(rankedMenuItemIds, row).getName());
+    });
 
     const MenuItemData item = maybeItem.value();
 
-    shared_ptr<GridNode> itemDisplay = make_shared<GridNode>();
-    shared_ptr<TextNode> itemDescription =
-        make_shared<TextNode>(item.getDescription());
-    shared_ptr<TextNode> itemPrice = make_shared<TextNode>(
-        "Base price: ₱" + formatNumber(item.getBasePrice()));
+    GridNode* itemDisplay = nodeArena.make<GridNode>();
+    TextNode* itemDescription =
+        nodeArena.make<TextNode>(item.getDescription());
+    TextNode* itemPrice =
+        nodeArena.make<TextNode>(basePriceText(item));
 
     itemDisplay->setRowGap(1);
     itemDisplay->setIsFlexible(false);
@@ -344,7 +489,7 @@ void Renderer::createMenuView(bool isNew) {
      * TODO: fix bug when order of appending is
      * reversed below.
      */
-    menuGrid->appendChild(menuSelect);
+    menuGrid->appendChild(menuList);
     menuGrid->appendChild(itemDisplay);
 
     /**
@@ -360,10 +505,10 @@ void Renderer::createMenuView(bool isNew) {
 void Renderer::createMenuItemView(bool isNew) {
     Screen& screen = getScreen();
     State& state = getState();
-    shared_ptr<GridNode> menuItemMetadataContainer =
-        make_shared<GridNode>(screen.getWidth(), screen.getWidth());
-    shared_ptr<GridNode> menuItemDynamicMetadataContainer =
-        make_shared<GridNode>(screen.getWidth(), 0);
+    GridNode* menuItemMetadataContainer =
+        nodeArena.make<GridNode>(screen.getWidth(), screen.getWidth());
+    GridNode* menuItemDynamicMetadataContainer =
+        nodeArena.make<GridNode>(screen.getWidth(), 0);
 
     menuItemMetadataContainer->setRowGap(1);
     menuItemDynamicMetadataContainer->setRowGap(1);
@@ -378,31 +523,28 @@ void Renderer::createMenuItemView(bool isNew) {
 
     MenuItem* currMenuItem = maybeCurrMenuItem.value();
 
-    shared_ptr<TextNode> menuItemName =
-        make_shared<TextNode>(currMenuItem->getName());
-    shared_ptr<TextNode> menuItemDescription = make_shared<TextNode>(
+    TextNode* menuItemName =
+        nodeArena.make<TextNode>(currMenuItem->getName());
+    TextNode* menuItemDescription = nodeArena.make<TextNode>(
         state.getMenuItemDataWithName(currMenuItem->getName())
             .value()
             .getDescription());
 
-    // TODO: Add add-ons to subtotal
-    shared_ptr<TextNode> menuItemPrice = make_shared<TextNode>(
-        "Base price: ₱" + formatNumber(currMenuItem->getBasePrice()) +
-        ", Subtotal: ₱" + formatNumber(currMenuItem->calculateSubtotal()));
+    TextNode* menuItemPrice =
+        nodeArena.make<TextNode>(subtotalText(currMenuItem));
 
     menuItemMetadataContainer->appendChild(menuItemName);
     menuItemMetadataContainer->appendChild(menuItemDescription);
     menuItemMetadataContainer->appendChild(menuItemPrice);
 
-    shared_ptr<TextNode> size =
-        make_shared<TextNode>("size: " + toString(currMenuItem->getSize()));
-    shared_ptr<TextNode> qty = make_shared<TextNode>(
-        "- " + formatNumber(currMenuItem->getQty()) + " +");
+    TextNode* size =
+        nodeArena.make<TextNode>("size: " + toString(currMenuItem->getSize()));
+    TextNode* qty = nodeArena.make<TextNode>(qtyText(currMenuItem));
 
     menuItemDynamicMetadataContainer->appendChild(size);
     menuItemDynamicMetadataContainer->appendChild(qty);
 
-    auto br = make_shared<LineBreakNode>(2);
+    auto br = nodeArena.make<LineBreakNode>(2);
 
     body->appendChild(menuItemMetadataContainer);
     body->appendChild(br);
@@ -420,24 +562,24 @@ void Renderer::createMenuItemConfirmView(bool isNew) {
 
     MenuItem* menuItem = maybeMenuItem.value();
 
-    shared_ptr<GridNode> textContainer =
-        make_shared<GridNode>(screen.getWidth(), screen.getWidth());
+    GridNode* textContainer =
+        nodeArena.make<GridNode>(screen.getWidth(), screen.getWidth());
 
     textContainer->setRowGap(0);
     textContainer->setIsFlexible(false);
 
-    shared_ptr<TextNode> menuItemName = make_shared<TextNode>(
+    TextNode* menuItemName = nodeArena.make<TextNode>(
         menuItem->getName() + " will be added to your cart.");
-    shared_ptr<LineBreakNode> br = make_shared<LineBreakNode>(1);
-    shared_ptr<TextNode> sizeText =
-        make_shared<TextNode>("Size: " + toString(menuItem->getSize()));
-    shared_ptr<TextNode> qtyText =
-        make_shared<TextNode>("Quantity: " + formatNumber(menuItem->getQty()));
-    shared_ptr<TextNode> subtotalText = make_shared<TextNode>(
+    LineBreakNode* br = nodeArena.make<LineBreakNode>(1);
+    TextNode* sizeText =
+        nodeArena.make<TextNode>("Size: " + toString(menuItem->getSize()));
+    TextNode* qtyText =
+        nodeArena.make<TextNode>("Quantity: " + formatNumber(menuItem->getQty()));
+    TextNode* subtotalText = nodeArena.make<TextNode>(
         "Subtotal: ₱" + formatNumber(menuItem->calculateSubtotal()));
-    shared_ptr<LineBreakNode> secondBr = make_shared<LineBreakNode>(2);
-    shared_ptr<TextNode> confirmationText =
-        make_shared<TextNode>("Press enter to confirm...");
+    LineBreakNode* secondBr = nodeArena.make<LineBreakNode>(2);
+    TextNode* confirmationText =
+        nodeArena.make<TextNode>("Press enter to confirm...");
 
     textContainer->appendChild(menuItemName);
     textContainer->appendChild(br);
@@ -452,14 +594,14 @@ void Renderer::createMenuItemConfirmView(bool isNew) {
 
 void Renderer::createMenuItemSizesView(bool isNew) {
 	State& state = getState();
-    shared_ptr<GridNode> menuGrid = make_shared<GridNode>();
-    shared_ptr<SelectNode> menuSelect = make_shared<SelectNode>();
+    GridNode* menuGrid = nodeArena.make<GridNode>();
+    SelectNode* menuSelect = nodeArena.make<SelectNode>();
 
     menuGrid->setIsFlexible(true);
 
     for (const auto item : state.getMenuItemSizesData()) {
-        shared_ptr<SelectOptionNode> optionNode =
-            make_shared<SelectOptionNode>(toString(item.getSize()));
+        SelectOptionNode* optionNode =
+            nodeArena.make<SelectOptionNode>(toString(item.getSize()));
 
         menuSelect->appendChild(optionNode);
     }
@@ -480,17 +622,15 @@ void Renderer::createMenuItemSizesView(bool isNew) {
     assert(
         maybeItem != nullopt);
 
-    shared_ptr<ContainerNode> activeMenuItemNode = make_shared<ContainerNode>();
-
     menuSelect->subscribe(onMenuSelectUpdated);
 
     const MenuItemSizeData item = maybeItem.value();
 
-    shared_ptr<GridNode> itemDisplay = make_shared<GridNode>();
-    shared_ptr<TextNode> itemDescription =
-        make_shared<TextNode>(item.getDescription());
-    shared_ptr<TextNode> itemPrice = make_shared<TextNode>(
-        "Additional price: ₱" + formatNumber(item.getAdditionalPrice()));
+    GridNode* itemDisplay = nodeArena.make<GridNode>();
+    TextNode* itemDescription =
+        nodeArena.make<TextNode>(item.getDescription());
+    TextNode* itemPrice =
+        nodeArena.make<TextNode>(additionalPriceText(item));
 
     itemDisplay->setRowGap(1);
     itemDisplay->setIsFlexible(false);
@@ -517,27 +657,28 @@ void Renderer::createMenuItemAddonsView(bool isNew) {}
 void Renderer::createOrderConfirmationView(bool isNew) {
     Screen& screen = getScreen();
     State& state = getState();
-    shared_ptr<GridNode> container =
-        make_shared<GridNode>(screen.getWidth(), screen.getWidth());
+    GridNode* container =
+        nodeArena.make<GridNode>(screen.getWidth(), screen.getWidth());
     const vector<MenuItem> cartItems = state.getMenuItemsInCart();
 
     container->setIsFlexible(false);
     container->setRowGap(2);
 
     if (cartItems.empty()) {
-        shared_ptr<TextNode> emptyText =
-            make_shared<TextNode>("There are no items in cart yet :(.");
+        TextNode* emptyText =
+            nodeArena.make<TextNode>("There are no items in cart yet :(.");
 
         container->appendChild(emptyText);
     } else {
-        shared_ptr<GridNode> cartGrid =
-            make_shared<GridNode>(screen.getWidth(), screen.getWidth() / 7);
+        TableNode* cartTable = nodeArena.make<TableNode>(
+            vector<string>{"Item", "Size", "Quantity", "Subtotal"},
+            rowsLeftOnScreen(ORDER_CONFIRMATION_CHROME_ROWS));
 
-        cartGrid->setColGap(1);
-        cartGrid->setRowGap(1);
+        cartTable->setColumnAlign(2, TableColumnAlign::RIGHT_ALIGN);
+        cartTable->setColumnAlign(3, TableColumnAlign::RIGHT_ALIGN);
 
-        shared_ptr<TextNode> title =
-            make_shared<TextNode>("The ordered items are:");
+        TextNode* title =
+            nodeArena.make<TextNode>("The ordered items are:");
 
         container->appendChild(title);
 
@@ -547,35 +688,16 @@ void Renderer::createOrderConfirmationView(bool isNew) {
             double subTotal = item.calculateSubtotal();
             total += subTotal;
 
-            shared_ptr<GridNode> cartItemGrid = make_shared<GridNode>(
-                screen.getWidth() / 7, screen.getWidth() / 7);
-
-            cartItemGrid->setRowGap(0);
-            cartItemGrid->setIsFlexible(false);
-
-            shared_ptr<TextNode> itemName =
-                make_shared<TextNode>(item.getName() + " " + item.getUid());
-            shared_ptr<LineBreakNode> br = make_shared<LineBreakNode>(1);
-            shared_ptr<TextNode> itemQty =
-                make_shared<TextNode>("Quantity: " + to_string(item.getQty()));
-            shared_ptr<TextNode> itemSize =
-                make_shared<TextNode>("Size: " + toString(item.getSize()));
-            shared_ptr<TextNode> itemPrice =
-                make_shared<TextNode>("Subtotal: ₱" + formatNumber(subTotal));
-
-            cartItemGrid->appendChild(itemName);
-            cartItemGrid->appendChild(br);
-            cartItemGrid->appendChild(itemQty);
-            cartItemGrid->appendChild(itemSize);
-            cartItemGrid->appendChild(itemPrice);
-
-            cartGrid->appendChild(cartItemGrid);
+            cartTable->appendRow({item.getName() + " " + item.getUid(),
+                                  toString(item.getSize()),
+                                  to_string(item.getQty()),
+                                  "₱" + formatNumber(subTotal)});
         }
 
-        container->appendChild(cartGrid);
+        container->appendChild(cartTable);
 
-        shared_ptr<TextNode> subMetadata =
-            make_shared<TextNode>("Total: ₱" + formatNumber(total));
+        TextNode* subMetadata =
+            nodeArena.make<TextNode>("Total: ₱" + formatNumber(total));
 
         container->appendChild(subMetadata);
     }
@@ -593,37 +715,26 @@ void Renderer::createOrderResultsView(bool isNew) {
 
     Order order = maybeOrder.value();
 
-    shared_ptr<GridNode> viewContainer =
-        make_shared<GridNode>(screen.getWidth(), screen.getWidth() / 7);
+    TableNode* itemsTable = nodeArena.make<TableNode>(
+        vector<string>{"Item", "Subtotal"},
+        rowsLeftOnScreen(ORDER_RESULTS_CHROME_ROWS));
 
-    viewContainer->setIsFlexible(false);
+    itemsTable->setColumnAlign(1, TableColumnAlign::RIGHT_ALIGN);
 
     for (auto& item : order.getItems()) {
-        shared_ptr<GridNode> itemCard = make_shared<GridNode>(
-            screen.getWidth() / 7, screen.getWidth() / 7, 1, 0);
-
-        itemCard->setIsFlexible(false);
-
-        shared_ptr<TextNode> itemName =
-            make_shared<TextNode>(item.getName() + " " + item.getUid());
-        shared_ptr<TextNode> itemSubtotal =
-            make_shared<TextNode>("₱" + formatNumber(item.calculateSubtotal()));
-
-        itemCard->appendChild(itemName);
-        itemCard->appendChild(itemSubtotal);
-
-        viewContainer->appendChild(itemCard);
+        itemsTable->appendRow({item.getName() + " " + item.getUid(),
+                               "₱" + formatNumber(item.calculateSubtotal())});
     }
 
-    shared_ptr<LineBreakNode> br = make_shared<LineBreakNode>(1);
-    shared_ptr<GridNode> orderMetadata =
-        make_shared<GridNode>(screen.getWidth(), 0, 2, 1);
+    LineBreakNode* br = nodeArena.make<LineBreakNode>(1);
+    GridNode* orderMetadata =
+        nodeArena.make<GridNode>(screen.getWidth(), 0, 2, 1);
 
-    shared_ptr<TextNode> vatNode =
-        make_shared<TextNode>("VAT: " + formatNumber(order.getVAT()));
-    shared_ptr<TextNode> totalPriceNode =
-        make_shared<TextNode>("Total: " + formatNumber(order.getTotalPrice()));
-    shared_ptr<TextNode> orderStateNode = make_shared<TextNode>(
+    TextNode* vatNode =
+        nodeArena.make<TextNode>("VAT: " + formatNumber(order.getVAT()));
+    TextNode* totalPriceNode =
+        nodeArena.make<TextNode>("Total: " + formatNumber(order.getTotalPrice()));
+    TextNode* orderStateNode = nodeArena.make<TextNode>(
         "Status: " + orderStateToString(order.getOrderState()));
 
     orderMetadata->setIsFlexible(false);
@@ -632,238 +743,126 @@ void Renderer::createOrderResultsView(bool isNew) {
     orderMetadata->appendChild(totalPriceNode);
     orderMetadata->appendChild(orderStateNode);
 
-    body->appendChild(viewContainer);
+    body->appendChild(itemsTable);
     body->appendChild(br);
     body->appendChild(orderMetadata);
 }
 
-void Renderer::createAdminMenuView(bool isNew) {}
+static string formatSalesGrade(const string& label,
+                               const SalesGradeResult& result) {
+    string text = label + ": ₱" + formatNumber(result.revenue);
 
-void Renderer::createMenuFooter(bool isNew) {
-    shared_ptr<GridNode> toolTipsContainer = make_shared<GridNode>();
+    if (result.grade == SalesGrade::UNGRADED) {
+        return text + " (not enough history to grade)";
+    }
 
-    toolTipsContainer->setColGap(2);
-    toolTipsContainer->setRowGap(1);
+    return text + " (expected ₱" + formatNumber(result.expected) + ") - " +
+           salesGradeToString(result.grade);
+}
 
-    shared_ptr<ButtonNode> enterBtn = make_shared<ButtonNode>(
-        "\u23CE", "enter", make_tuple(KEY_ENTER, KEY_ENTER_LINUX), true);
-    // Just a text
-    shared_ptr<ButtonNode> upDownBtn =
-        make_shared<ButtonNode>("↑/↓", "up/down", make_tuple(0, 0), true);
-    shared_ptr<ButtonNode> quitBtn =
-        make_shared<ButtonNode>("q", "quit", make_tuple(0, 0), true);
+void Renderer::createAdminMenuView(bool isNew) {
+    Screen& screen = getScreen();
+    State& state = getState();
+    SalesGrader& grader = getSalesGrader();
+    tm now = getCurrentDateTime();
+
+    GridNode* gradesContainer =
+        nodeArena.make<GridNode>(screen.getWidth(), screen.getWidth());
+
+    gradesContainer->setIsFlexible(false);
+    gradesContainer->setRowGap(1);
+
+    TextNode* hourGrade = nodeArena.make<TextNode>(
+        formatSalesGrade("Sales this hour", grader.gradeHour(now)));
+    TextNode* dayGrade = nodeArena.make<TextNode>(
+        formatSalesGrade("Sales today", grader.gradeDay(now)));
+
+    vector<SalesCubeRow> itemsSoldToday =
+        getSalesCube().run(SalesQuery()
+                               .between(now, now)
+                               .withoutState(OrderState::CANCELLED)
+                               .measure(SalesMeasure::QUANTITY));
+    TextNode* itemsSold = nodeArena.make<TextNode>(
+        "Items sold today: " +
+        to_string(itemsSoldToday.empty()
+                      ? 0
+                      : static_cast<size_t>(itemsSoldToday.front().sum)));
+
+    gradesContainer->appendChild(hourGrade);
+    gradesContainer->appendChild(dayGrade);
+    gradesContainer->appendChild(itemsSold);
+
+    for (const auto& item : state.getMenuItemsData()) {
+        TextNode* itemGrade = nodeArena.make<TextNode>(
+            formatSalesGrade(item.getName(),
+                             grader.gradeItem(item.getName(), now)));
+
+        gradesContainer->appendChild(itemGrade);
+    }
 
-    enterBtn->subscribe(onEnterBtnClickedMenuSelect);
+    TextNode* prepHeading = nodeArena.make<TextNode>(
+        "To prep for the next " + to_string(DEMAND_PREP_WINDOW_HOURS) +
+        " hours:");
 
-    toolTipsContainer->appendChild(enterBtn);
-    toolTipsContainer->appendChild(upDownBtn);
-    toolTipsContainer->appendChild(quitBtn);
+    gradesContainer->appendChild(prepHeading);
 
-    shared_ptr<TextNode> lineSeparatorUp =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-    shared_ptr<TextNode> lineSeparatorBottom =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
+    for (const auto& item : state.getMenuItemsData()) {
+        double quantity = state.getPrepForecast(item.getName());
 
-    footer->appendChild(lineSeparatorUp);
-    footer->appendChild(toolTipsContainer);
-    footer->appendChild(lineSeparatorBottom);
-}
+        if (quantity < 0.5) {
+            continue;
+        }
 
-void Renderer::createMenuItemFooter(bool isNew) {
-    shared_ptr<GridNode> toolTipsContainer = make_shared<GridNode>();
-
-    toolTipsContainer->setColGap(2);
-    toolTipsContainer->setRowGap(1);
-
-    shared_ptr<ButtonNode> enterBtn = make_shared<ButtonNode>(
-        "\u23CE", "enter", make_tuple(KEY_ENTER, KEY_ENTER_LINUX), true);
-    shared_ptr<ButtonNode> upDownBtn = make_shared<ButtonNode>(
-        "-/+", "add/minus", make_tuple(KEY_HYPHEN_MINUS, KEY_PLUS), true);
-    // just a text
-    shared_ptr<ButtonNode> quitBtn =
-        make_shared<ButtonNode>("q", "quit", make_tuple(0, 0), true);
-
-    enterBtn->subscribe(onEnterBtnClickedMenuSelect);
-    upDownBtn->subscribe(onAddMinusBtnClicked);
-
-    toolTipsContainer->appendChild(enterBtn);
-    toolTipsContainer->appendChild(upDownBtn);
-    toolTipsContainer->appendChild(quitBtn);
-
-    shared_ptr<TextNode> lineSeparatorUp =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-    shared_ptr<TextNode> lineSeparatorBottom =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-
-    footer->appendChild(lineSeparatorUp);
-    footer->appendChild(toolTipsContainer);
-    footer->appendChild(lineSeparatorBottom);
-}
+        TextNode* itemPrep = nodeArena.make<TextNode>(
+            "  " + item.getName() + " x" + formatNumber(quantity, 0));
 
-void Renderer::createMenuItemConfirmFooter(bool isNew) {
-    shared_ptr<GridNode> toolTipsContainer = make_shared<GridNode>();
+        gradesContainer->appendChild(itemPrep);
+    }
 
-    toolTipsContainer->setColGap(2);
-    toolTipsContainer->setRowGap(1);
+    // yesterday's totals would pass for today's
+    if (zReport.has_value() && zReport.value().getDate() != parseDate(now)) {
+        zReport.reset();
+    }
 
-    shared_ptr<ButtonNode> enterBtn =
-        make_shared<ButtonNode>("\u23CE(enter)", "confirm",
-                                make_tuple(KEY_ENTER, KEY_ENTER_LINUX), true);
-    // Just a text
-    shared_ptr<ButtonNode> quitBtn =
-        make_shared<ButtonNode>("q", "quit", make_tuple(0, 0), true);
+    if (zReport.has_value()) {
+        for (const auto& line : zReport.value().toLines()) {
+            gradesContainer->appendChild(nodeArena.make<TextNode>(line));
+        }
+    }
 
-    enterBtn->subscribe(onEnterBtnClickedMenuSelect);
+    body->appendChild(gradesContainer);
+}
 
-    toolTipsContainer->appendChild(enterBtn);
-    toolTipsContainer->appendChild(quitBtn);
+void Renderer::createMenuFooter(bool isNew) { createToolTips(LIST_FOOTER); }
 
-    shared_ptr<TextNode> lineSeparatorUp =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-    shared_ptr<TextNode> lineSeparatorBottom =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
+void Renderer::createMenuItemFooter(bool isNew) {
+    createToolTips(MENU_ITEM_FOOTER);
+}
 
-    footer->appendChild(lineSeparatorUp);
-    footer->appendChild(toolTipsContainer);
-    footer->appendChild(lineSeparatorBottom);
+void Renderer::createMenuItemConfirmFooter(bool isNew) {
+    createToolTips(MENU_ITEM_CONFIRM_FOOTER);
 }
 
 void Renderer::createMenuItemSizesFooter(bool isNew) {
-    shared_ptr<GridNode> toolTipsContainer = make_shared<GridNode>();
-
-    toolTipsContainer->setColGap(2);
-    toolTipsContainer->setRowGap(1);
-
-    shared_ptr<ButtonNode> enterBtn = make_shared<ButtonNode>(
-        "\u23CE", "enter", make_tuple(KEY_ENTER, KEY_ENTER_LINUX), true);
-    // Just a text
-    shared_ptr<ButtonNode> upDownBtn =
-        make_shared<ButtonNode>("↑/↓", "up/down", make_tuple(0, 0), true);
-    shared_ptr<ButtonNode> quitBtn =
-        make_shared<ButtonNode>("q", "quit", make_tuple(0, 0), true);
-
-    enterBtn->subscribe(onEnterBtnClickedMenuSelect);
-
-    toolTipsContainer->appendChild(enterBtn);
-    toolTipsContainer->appendChild(upDownBtn);
-    toolTipsContainer->appendChild(quitBtn);
-
-    shared_ptr<TextNode> lineSeparatorUp =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-    shared_ptr<TextNode> lineSeparatorBottom =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-
-    footer->appendChild(lineSeparatorUp);
-    footer->appendChild(toolTipsContainer);
-    footer->appendChild(lineSeparatorBottom);
+    createToolTips(LIST_FOOTER);
 }
 
 void Renderer::createMenuItemAddonsFooter(bool isNew) {
-    shared_ptr<GridNode> toolTipsContainer = make_shared<GridNode>();
-
-    toolTipsContainer->setColGap(2);
-    toolTipsContainer->setRowGap(1);
-
-    // Just a text
-    shared_ptr<ButtonNode> quitBtn =
-        make_shared<ButtonNode>("q", "quit", make_tuple(0, 0), true);
-
-    toolTipsContainer->appendChild(quitBtn);
-
-    shared_ptr<TextNode> lineSeparatorUp =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-    shared_ptr<TextNode> lineSeparatorBottom =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-
-    footer->appendChild(lineSeparatorUp);
-    footer->appendChild(toolTipsContainer);
-    footer->appendChild(lineSeparatorBottom);
+    createToolTips(QUIT_FOOTER);
 }
 
 void Renderer::createOrderConfirmationFooter(bool isNew) {
-    State& state = getState();
-
-    shared_ptr<GridNode> toolTipsContainer = make_shared<GridNode>();
-
-    toolTipsContainer->setColGap(2);
-    toolTipsContainer->setRowGap(1);
-
-    if (!state.getMenuItemsInCart().empty()) {
-        shared_ptr<ButtonNode> backBtn = make_shared<ButtonNode>(
-            "←(esc)", "clear", make_tuple(KEY_ESC, KEY_ESC), true);
-        shared_ptr<ButtonNode> enterBtn = make_shared<ButtonNode>(
-            "\u23CE(enter)", "confirm", make_tuple(KEY_ENTER, KEY_ENTER_LINUX),
-            true);
-
-        backBtn->subscribe(onEscBtnClickedOnMenuItem);
-        enterBtn->subscribe(onEnterBtnClickedMenuSelect);
-
-        toolTipsContainer->appendChild(backBtn);
-        toolTipsContainer->appendChild(enterBtn);
-    }
-
-    // Just a text
-    shared_ptr<ButtonNode> quitBtn =
-        make_shared<ButtonNode>("q", "quit", make_tuple(0, 0), true);
-
-    toolTipsContainer->appendChild(quitBtn);
-
-    shared_ptr<TextNode> lineSeparatorUp =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-    shared_ptr<TextNode> lineSeparatorBottom =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-
-    footer->appendChild(lineSeparatorUp);
-    footer->appendChild(toolTipsContainer);
-    footer->appendChild(lineSeparatorBottom);
+    createToolTips(getState().getMenuItemsInCart().empty()
+                       ? QUIT_FOOTER
+                       : ORDER_CONFIRMATION_FOOTER);
 }
 
 void Renderer::createOrderResultsFooter(bool isNew) {
-    shared_ptr<GridNode> toolTipsContainer = make_shared<GridNode>();
-
-    toolTipsContainer->setColGap(2);
-    toolTipsContainer->setRowGap(1);
-
-    shared_ptr<ButtonNode> backBtn = make_shared<ButtonNode>(
-        "←(esc)", "BACK", make_tuple(KEY_ESC, KEY_ESC), true);
-    // Just a text
-    shared_ptr<ButtonNode> quitBtn =
-        make_shared<ButtonNode>("q", "quit", make_tuple(0, 0), true);
-
-    backBtn->subscribe(onEscBtnClickedOnMenuItem);
-
-    toolTipsContainer->appendChild(backBtn);
-    toolTipsContainer->appendChild(quitBtn);
-
-    shared_ptr<TextNode> lineSeparatorUp =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-    shared_ptr<TextNode> lineSeparatorBottom =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-
-    footer->appendChild(lineSeparatorUp);
-    footer->appendChild(toolTipsContainer);
-    footer->appendChild(lineSeparatorBottom);
+    createToolTips(ORDER_RESULTS_FOOTER);
 }
 
 void Renderer::createAdminMenuFooter(bool isNew) {
-    shared_ptr<GridNode> toolTipsContainer = make_shared<GridNode>();
-
-    toolTipsContainer->setColGap(2);
-    toolTipsContainer->setRowGap(1);
-
-    shared_ptr<ButtonNode> quitBtn =
-        make_shared<ButtonNode>("q", "quit", make_tuple(0, 0), true);
-
-    toolTipsContainer->appendChild(quitBtn);
-
-    shared_ptr<TextNode> lineSeparatorUp =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-    shared_ptr<TextNode> lineSeparatorBottom =
-        make_shared<TextNode>(string(toolTipsContainer->getWidth(), '-'));
-
-    footer->appendChild(lineSeparatorUp);
-    footer->appendChild(toolTipsContainer);
-    footer->appendChild(lineSeparatorBottom);
+    createToolTips(ADMIN_MENU_FOOTER);
 }
 
 void Renderer::renderBuffer() noexcept {
@@ -873,24 +872,18 @@ void Renderer::renderBuffer() noexcept {
 }
 
 void Renderer::onKeyPressed(unsigned int keyCode) {
-    onKeyPressed(keyCode, rootNode);
-}
+    isDispatchingKey = true;
+    keepsDispatchedView = false;
 
-void Renderer::onKeyPressed(unsigned int keyCode, Node::NodePtr currNode) {
-    // base case
-    if (!currNode->canHaveChildren()) {
-        return;
-    }
-
-    const vector<Node::NodePtr>& children = currNode->getChildren();
+    keyBindings.dispatch(keyCode);
 
-    for (auto& c : children) {
-        if (c->nodeType() == NodeTypes::INTERACTABLE) {
-            static_pointer_cast<InteractableNode>(c)->onKeyPressed(keyCode);
-        }
+    isDispatchingKey = false;
+    dispatchedNodeArena.reset();
 
-        onKeyPressed(keyCode, c);
-    }
+    // nodes that only scrolled didn't have a handler create a
+    // new view, so whatever they flagged is painted here
+    updateView();
+    renderBuffer();
 }
 
 void onMenuSelectUpdated(optional<string> selectedMenuSelectName) {
@@ -910,12 +903,6 @@ void onMenuSelectUpdated(optional<string> selectedMenuSelectName) {
         }
     }
 
-    /**
-     *
-     * TODO:
-     *
-     * Only update the changed components
-     */
     renderer.createView();
     renderer.renderBuffer();
 }
@@ -1121,3 +1108,12 @@ void onCheckoutBtnClicked(unsigned int) {
     renderer.createView();
     renderer.renderBuffer();
 }
+
+void onZReportBtnClicked(unsigned int) {
+    Renderer& renderer = getRenderer();
+
+    renderer.zReport = generateZReport(getCurrentDateTime());
+
+    renderer.createView();
+    renderer.renderBuffer();
+}
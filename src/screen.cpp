@@ -14,25 +14,16 @@ void initializeScreen() {
 }
 
 Screen::Screen() { updateScreenDimensions(); }
-Screen::~Screen() { subscribers.clear(); }
+Screen::~Screen() { subscribers.disconnectAll(); }
 
-void Screen::notify() {
-    for (const auto subscriber : subscribers) {
-        subscriber();
-    }
-}
+void Screen::notify() { subscribers.emit(); }
 
-void Screen::subscribe(Screen::SubscriberCallback cb) {
-    subscribers.push_back(cb);
+Connection Screen::subscribe(Screen::SubscriberCallback cb) {
+    return subscribers.connect(cb);
 }
 
-void Screen::unsubscribe(Screen::SubscriberCallback cb) {
-    subscribers.erase(remove_if(subscribers.begin(), subscribers.end(),
-                                [&cb](const Screen::SubscriberCallback currCb) {
-                                    return currCb.target_type() ==
-                                           cb.target_type();
-                                }),
-                      subscribers.end());
+void Screen::unsubscribe(Connection connection) noexcept {
+    subscribers.disconnect(connection);
 }
 
 unsigned int Screen::getWidth() const noexcept { return width; }
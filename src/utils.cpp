@@ -1,5 +1,11 @@
 #include <utils.hpp>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <cstring>
+
 #if defined(LINUX_PLATFORM) || defined(MAC_PLATFORM)
 void miscellaneous::wait(unsigned int durationInMs) {
     sleep(durationInMs / 1000);
@@ -18,34 +24,37 @@ string string_utils::kebabToPascal(const string &str) noexcept {
 
 string string_utils::kebabToPascal(const string &str,
                                    const bool addSpace) noexcept {
-    stringstream res;
+    string res;
 
+    appendKebabToPascal(res, str, addSpace);
+
+    return res;
+}
+
+void string_utils::appendKebabToPascal(string &res, const string &str,
+                                       const bool addSpace) noexcept {
     for (size_t i = 0, l = str.size(); i < l; ++i) {
-        const char &ch = str.at(i);
+        const char &ch = str[i];
 
         if (i == 0) {
-            res << static_cast<char>(toupper(ch));
+            res += static_cast<char>(toupper(ch));
 
             continue;
         } else if (ch == '-') {
-            try {
-                const char &ch2 = str.at(++i);
-
+            // a trailing hyphen is dropped
+            if (++i < l) {
                 if (addSpace) {
-                    res << " ";
+                    res += ' ';
                 }
 
-                res << static_cast<char>(toupper(ch2));
-            } catch (const out_of_range &) {
+                res += static_cast<char>(toupper(str[i]));
             }
 
             continue;
         }
 
-        res << ch;
+        res += ch;
     }
-
-    return res.str();
 }
 
 // From ChatGPT
@@ -93,6 +102,184 @@ size_t string_utils::numOfUtf8Chars(const string &str) {
     return count;
 }
 
+static const char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+size_t string_utils::decodeUtf8(const string &str, size_t idx,
+                                char32_t &codePoint) noexcept {
+    unsigned char lead = static_cast<unsigned char>(str[idx]);
+    size_t len;
+
+    if ((lead & 0x80) == 0) {
+        codePoint = lead;
+
+        return 1;
+    } else if ((lead & 0xE0) == 0xC0) {
+        codePoint = lead & 0x1F;
+        len = 2;
+    } else if ((lead & 0xF0) == 0xE0) {
+        codePoint = lead & 0x0F;
+        len = 3;
+    } else if ((lead & 0xF8) == 0xF0) {
+        codePoint = lead & 0x07;
+        len = 4;
+    } else {
+        codePoint = REPLACEMENT_CHARACTER;
+
+        return 1;
+    }
+
+    // remarks and item names come from files, so a stray byte
+    // is drawn as one column instead of taking the app down
+    if (idx + len > str.size()) {
+        codePoint = REPLACEMENT_CHARACTER;
+
+        return 1;
+    }
+
+    for (size_t i = 1; i < len; ++i) {
+        unsigned char next = static_cast<unsigned char>(str[idx + i]);
+
+        if ((next & 0xC0) != 0x80) {
+            codePoint = REPLACEMENT_CHARACTER;
+
+            return 1;
+        }
+
+        codePoint = (codePoint << 6) | (next & 0x3F);
+    }
+
+    return len;
+}
+
+struct CodePointRange {
+    char32_t first;
+    char32_t last;
+};
+
+/**
+ *
+ * Combining marks, zero-width spaces and joiners, and
+ * variation selectors. Sorted for binary search.
+ */
+static const CodePointRange ZERO_WIDTH_RANGES[] = {
+    {0x0300, 0x036F},   {0x0483, 0x0489},   {0x0591, 0x05BD},
+    {0x05BF, 0x05BF},   {0x05C1, 0x05C2},   {0x05C4, 0x05C5},
+    {0x05C7, 0x05C7},   {0x0610, 0x061A},   {0x064B, 0x065F},
+    {0x0670, 0x0670},   {0x06D6, 0x06DC},   {0x06DF, 0x06E4},
+    {0x06E7, 0x06E8},   {0x06EA, 0x06ED},   {0x0E31, 0x0E31},
+    {0x0E34, 0x0E3A},   {0x0E47, 0x0E4E},   {0x1AB0, 0x1AFF},
+    {0x1DC0, 0x1DFF},   {0x200B, 0x200F},   {0x2028, 0x202E},
+    {0x2060, 0x2064},   {0x20D0, 0x20FF},   {0xFE00, 0xFE0F},
+    {0xFE20, 0xFE2F},   {0xFEFF, 0xFEFF},   {0xE0100, 0xE01EF}};
+
+/**
+ *
+ * East Asian wide and fullwidth characters, and emoji drawn
+ * two columns wide. Sorted for binary search.
+ */
+static const CodePointRange WIDE_RANGES[] = {
+    {0x1100, 0x115F},   {0x231A, 0x231B},   {0x2329, 0x232A},
+    {0x23E9, 0x23EC},   {0x23F0, 0x23F0},   {0x23F3, 0x23F3},
+    {0x25FD, 0x25FE},   {0x2614, 0x2615},   {0x2648, 0x2653},
+    {0x267F, 0x267F},   {0x2693, 0x2693},   {0x26A1, 0x26A1},
+    {0x26AA, 0x26AB},   {0x26BD, 0x26BE},   {0x26C4, 0x26C5},
+    {0x26CE, 0x26CE},   {0x26D4, 0x26D4},   {0x26EA, 0x26EA},
+    {0x26F2, 0x26F3},   {0x26F5, 0x26F5},   {0x26FA, 0x26FA},
+    {0x26FD, 0x26FD},   {0x2705, 0x2705},   {0x270A, 0x270B},
+    {0x2728, 0x2728},   {0x274C, 0x274C},   {0x274E, 0x274E},
+    {0x2753, 0x2755},   {0x2757, 0x2757},   {0x2795, 0x2797},
+    {0x27B0, 0x27B0},   {0x27BF, 0x27BF},   {0x2B1B, 0x2B1C},
+    {0x2B50, 0x2B50},   {0x2B55, 0x2B55},   {0x2E80, 0x303E},
+    {0x3041, 0x4DBF},   {0x4E00, 0xA4CF},   {0xA960, 0xA97F},
+    {0xAC00, 0xD7A3},   {0xF900, 0xFAFF},   {0xFE10, 0xFE19},
+    {0xFE30, 0xFE6F},   {0xFF00, 0xFF60},   {0xFFE0, 0xFFE6},
+    {0x1F300, 0x1F64F}, {0x1F900, 0x1F9FF}, {0x20000, 0x2FFFD},
+    {0x30000, 0x3FFFD}};
+
+template <size_t N>
+static bool isInRanges(const CodePointRange (&ranges)[N],
+                       char32_t codePoint) noexcept {
+    if (codePoint < ranges[0].first || codePoint > ranges[N - 1].last) {
+        return false;
+    }
+
+    const CodePointRange *range = upper_bound(
+        ranges, ranges + N, codePoint,
+        [](char32_t cp, const CodePointRange &r) { return cp < r.first; });
+
+    return range != ranges && codePoint <= (range - 1)->last;
+}
+
+unsigned int string_utils::codePointWidth(char32_t codePoint) noexcept {
+    if (codePoint < 0x0300) {
+        return 1;
+    }
+
+    if (isInRanges(ZERO_WIDTH_RANGES, codePoint)) {
+        return 0;
+    }
+
+    return isInRanges(WIDE_RANGES, codePoint) ? 2 : 1;
+}
+
+/**
+ *
+ * How many bytes from the start of `data` are ASCII
+ */
+static size_t asciiPrefixLength(const char *data, size_t size) noexcept {
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    // a byte outside of ASCII has its top bit set, which movemask
+    // gathers for 16 bytes at once
+    for (; i + 16 <= size; i += 16) {
+        __m128i block =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+        if (_mm_movemask_epi8(block) != 0) {
+            break;
+        }
+    }
+#else
+    for (; i + 8 <= size; i += 8) {
+        uint64_t block;
+
+        memcpy(&block, data + i, sizeof(block));
+
+        if ((block & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+    }
+#endif
+
+    while (i < size && (static_cast<unsigned char>(data[i]) & 0x80) == 0) {
+        ++i;
+    }
+
+    return i;
+}
+
+size_t string_utils::displayWidth(const string &str) {
+    size_t width = 0;
+    size_t size = str.size();
+
+    for (size_t i = 0; i < size;) {
+        size_t asciiLength = asciiPrefixLength(str.data() + i, size - i);
+
+        width += asciiLength;
+        i += asciiLength;
+
+        if (i < size) {
+            char32_t codePoint;
+
+            i += decodeUtf8(str, i, codePoint);
+            width += codePointWidth(codePoint);
+        }
+    }
+
+    return width;
+}
+
 void terminal::moveCursorTo(const unsigned int col) noexcept {
     cout << ESC << (col) << "G";
 }
@@ -0,0 +1,136 @@
+#include <workpool.hpp>
+
+/** Pool the thread works for, and the queue it has there */
+static thread_local const WorkStealingPool* workerPool = nullptr;
+static thread_local size_t workerQueue = 0;
+
+TaskGroup::TaskGroup() noexcept : pendingCount(0) {}
+
+WorkStealingPool::WorkStealingPool(size_t threadCount)
+    : queuedCount(0), isStopping(false) {
+    threadCount = max<size_t>(threadCount, 1);
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues.push_back(make_unique<TaskQueue>());
+    }
+
+    for (size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&WorkStealingPool::work, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> lock(sleepLock);
+
+        isStopping = true;
+    }
+
+    wakeUp.notify_all();
+
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t WorkStealingPool::ownQueue() const noexcept {
+    return workerPool == this ? workerQueue : 0;
+}
+
+bool WorkStealingPool::takeTask(size_t self, Task& task) {
+    for (size_t i = 0; i < queues.size(); ++i) {
+        size_t victim = (self + i) % queues.size();
+        TaskQueue& queue = *queues[victim];
+        lock_guard<mutex> lock(queue.lock);
+
+        if (queue.tasks.empty()) {
+            continue;
+        }
+
+        // the newest of its own tasks is the one most likely to
+        // still be in the cache, the oldest of another thread's is
+        // the one most likely to fork more
+        if (victim == self) {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        } else {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+
+        queuedCount.fetch_sub(1, memory_order_relaxed);
+
+        return true;
+    }
+
+    return false;
+}
+
+void WorkStealingPool::runTask(Task& task) noexcept {
+    task.run();
+    task.group->pendingCount.fetch_sub(1, memory_order_release);
+}
+
+void WorkStealingPool::work(size_t self) {
+    workerPool = this;
+    workerQueue = self;
+
+    while (true) {
+        Task task;
+
+        if (takeTask(self, task)) {
+            runTask(task);
+
+            continue;
+        }
+
+        unique_lock<mutex> lock(sleepLock);
+
+        wakeUp.wait(lock, [this] {
+            return isStopping || queuedCount.load(memory_order_relaxed) > 0;
+        });
+
+        if (isStopping) {
+            return;
+        }
+    }
+}
+
+size_t WorkStealingPool::getThreadCount() const noexcept {
+    return queues.size();
+}
+
+void WorkStealingPool::fork(TaskGroup& group, Delegate<void()> run) {
+    TaskQueue& queue = *queues[ownQueue()];
+
+    group.pendingCount.fetch_add(1, memory_order_relaxed);
+
+    {
+        lock_guard<mutex> lock(queue.lock);
+
+        queue.tasks.push_back({run, &group});
+    }
+
+    queuedCount.fetch_add(1, memory_order_relaxed);
+
+    // taken so a worker can't miss the count going up between
+    // checking it and going to sleep
+    { lock_guard<mutex> lock(sleepLock); }
+
+    wakeUp.notify_one();
+}
+
+void WorkStealingPool::join(TaskGroup& group) {
+    size_t self = ownQueue();
+
+    while (group.pendingCount.load(memory_order_acquire) > 0) {
+        Task task;
+
+        if (takeTask(self, task)) {
+            runTask(task);
+        } else {
+            // what is left is running on other threads
+            this_thread::yield();
+        }
+    }
+}